@@ -0,0 +1,277 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../include/podi.h"
+#include <X11/Xlib.h>
+#include <X11/extensions/XTest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_THROUGHPUT_EVENTS 20000
+#define DEFAULT_LATENCY_SAMPLES 2000
+#define DEFAULT_LIFECYCLE_SAMPLES 200
+
+// Give up on a single injected event after this long
+#define DELIVERY_TIMEOUT_NS 1000000000ULL
+
+// How long to keep retrying while a freshly started X server comes up
+#define DISPLAY_TIMEOUT_NS 5000000000ULL
+
+// Events fetched per podi_application_poll_events() call in the batched run
+#define POLL_BATCH 256
+
+static int throughput_events = DEFAULT_THROUGHPUT_EVENTS;
+static int latency_samples = DEFAULT_LATENCY_SAMPLES;
+static int lifecycle_samples = DEFAULT_LIFECYCLE_SAMPLES;
+
+// Separate connection for XTest, so injection never shares podi's queue
+static Display *injector;
+static int window_root_x, window_root_y;
+
+void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("Options:\n");
+    printf("  --events N     Motion events for the throughput run (default %d)\n", DEFAULT_THROUGHPUT_EVENTS);
+    printf("  --latency N    Samples for the injection-to-delivery latency run (default %d)\n", DEFAULT_LATENCY_SAMPLES);
+    printf("  --windows N    Create/destroy cycles for the window lifecycle run (default %d)\n", DEFAULT_LIFECYCLE_SAMPLES);
+    printf("  --help, -h     Show this help message\n");
+    printf("\nRuns against the X11 backend; use 'make run' to start a private Xvfb.\n");
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static double percentile_us(uint64_t *sorted, int count, double fraction) {
+    int index = (int)(fraction * (count - 1) + 0.5);
+    return sorted[index] / 1000.0;
+}
+
+static void print_distribution(const char *name, uint64_t *samples, int count) {
+    if (count == 0) {
+        printf("%-24s no samples\n", name);
+        return;
+    }
+
+    qsort(samples, count, sizeof(uint64_t), compare_u64);
+    printf("%-24s p50 %9.1f us   p99 %9.1f us   max %9.1f us   (%d samples)\n", name,
+           percentile_us(samples, count, 0.50), percentile_us(samples, count, 0.99),
+           samples[count - 1] / 1000.0, count);
+}
+
+// Moves the pointer to a window-relative position; odd/even steps alternate
+// so every injection is a real motion
+static void inject_motion(int step) {
+    XTestFakeMotionEvent(injector, -1, window_root_x + 100 + (step & 1), window_root_y + 100, CurrentTime);
+}
+
+// Drains the queue until a mouse move arrives or the timeout expires
+static bool wait_for_motion(podi_application *app) {
+    uint64_t deadline = now_ns() + DELIVERY_TIMEOUT_NS;
+    podi_event event;
+    while (now_ns() < deadline) {
+        while (podi_application_poll_event(app, &event)) {
+            if (event.type == PODI_EVENT_MOUSE_MOVE) return true;
+        }
+    }
+    return false;
+}
+
+static void drain_events(podi_application *app, uint64_t duration_ns) {
+    uint64_t deadline = now_ns() + duration_ns;
+    podi_event event;
+    while (now_ns() < deadline) {
+        while (podi_application_poll_event(app, &event)) {
+        }
+    }
+}
+
+// Pulls up to one batch of events, one at a time or with a single call
+static size_t poll_batch(podi_application *app, podi_event *events, bool batched) {
+    if (batched) return podi_application_poll_events(app, events, POLL_BATCH);
+
+    size_t count = 0;
+    while (count < POLL_BATCH && podi_application_poll_event(app, &events[count])) {
+        count++;
+    }
+    return count;
+}
+
+static void bench_throughput(podi_application *app, bool batched) {
+    for (int i = 0; i < throughput_events; i++) {
+        inject_motion(i);
+    }
+    // Let the server generate everything before timing the client side
+    XSync(injector, False);
+
+    static podi_event events[POLL_BATCH];
+    int received = 0;
+    uint64_t start = now_ns();
+    uint64_t last_delivery = start;
+    while (received < throughput_events && now_ns() - last_delivery < DELIVERY_TIMEOUT_NS) {
+        size_t count = poll_batch(app, events, batched);
+        for (size_t i = 0; i < count; i++) {
+            if (events[i].type == PODI_EVENT_MOUSE_MOVE) {
+                received++;
+                last_delivery = now_ns();
+            }
+        }
+    }
+
+    double seconds = (last_delivery - start) / 1e9;
+    printf("%-24s %9.0f events/s   (%d of %d delivered in %.1f ms)\n",
+           batched ? "poll_events throughput" : "poll_event throughput",
+           seconds > 0.0 ? received / seconds : 0.0, received, throughput_events, seconds * 1000.0);
+}
+
+static void bench_latency(podi_application *app) {
+    uint64_t *samples = malloc(sizeof(uint64_t) * latency_samples);
+    if (!samples) return;
+
+    int count = 0;
+    for (int i = 0; i < latency_samples; i++) {
+        uint64_t start = now_ns();
+        inject_motion(i);
+        XFlush(injector);
+        if (wait_for_motion(app)) {
+            samples[count++] = now_ns() - start;
+        }
+    }
+
+    print_distribution("inject-to-delivery", samples, count);
+    free(samples);
+}
+
+static void bench_window_lifecycle(podi_application *app) {
+    uint64_t *create_samples = malloc(sizeof(uint64_t) * lifecycle_samples);
+    uint64_t *destroy_samples = malloc(sizeof(uint64_t) * lifecycle_samples);
+    if (!create_samples || !destroy_samples) {
+        free(create_samples);
+        free(destroy_samples);
+        return;
+    }
+
+    int count = 0;
+    for (int i = 0; i < lifecycle_samples; i++) {
+        uint64_t start = now_ns();
+        podi_window *window = podi_window_create(app, "podi bench lifecycle", 320, 240);
+        uint64_t created = now_ns();
+        if (!window) break;
+        podi_window_destroy(window);
+        uint64_t destroyed = now_ns();
+
+        create_samples[count] = created - start;
+        destroy_samples[count] = destroyed - created;
+        count++;
+
+        // Keep map/unmap notifications from piling up between cycles
+        podi_event event;
+        while (podi_application_poll_event(app, &event)) {
+        }
+    }
+
+    print_distribution("window create", create_samples, count);
+    print_distribution("window destroy", destroy_samples, count);
+    free(create_samples);
+    free(destroy_samples);
+}
+
+// Retries until the server accepts connections, so a just-started Xvfb
+// doesn't need a fixed sleep
+static Display *open_display(void) {
+    uint64_t deadline = now_ns() + DISPLAY_TIMEOUT_NS;
+    while (true) {
+        Display *display = XOpenDisplay(NULL);
+        if (display || now_ns() >= deadline) return display;
+
+        struct timespec delay = { .tv_sec = 0, .tv_nsec = 50000000L };
+        nanosleep(&delay, NULL);
+    }
+}
+
+int bench_main(podi_application *app) {
+    printf("=== PODI Event Path Benchmark ===\n");
+    printf("Backend: %s\n", podi_get_backend_name());
+
+    int result = 1;
+    podi_window *window = podi_window_create(app, "podi bench", 640, 480);
+    if (!window) {
+        printf("ERROR: Failed to create window\n");
+        goto cleanup;
+    }
+
+    // Wait for the map so injected motion lands in the window
+    drain_events(app, 200000000ULL);
+
+    podi_x11_handles handles;
+    if (!podi_window_get_x11_handles(window, &handles)) {
+        printf("ERROR: Benchmark requires the X11 backend\n");
+        goto cleanup;
+    }
+    Window child;
+    XTranslateCoordinates(injector, (Window)handles.window, DefaultRootWindow(injector),
+                          0, 0, &window_root_x, &window_root_y, &child);
+
+    inject_motion(0);
+    XFlush(injector);
+    if (!wait_for_motion(app)) {
+        printf("ERROR: Injected motion never reached the window\n");
+        goto cleanup;
+    }
+
+    bench_throughput(app, false);
+    bench_throughput(app, true);
+    bench_latency(app);
+    bench_window_lifecycle(app);
+    result = 0;
+
+cleanup:
+    if (window) podi_window_destroy(window);
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+            throughput_events = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
+            latency_samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--windows") == 0 && i + 1 < argc) {
+            lifecycle_samples = atoi(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // The injector connection is opened first; it also waits for the server
+    injector = open_display();
+    if (!injector) {
+        printf("ERROR: Cannot open display $DISPLAY\n");
+        return 1;
+    }
+
+    int result = 1;
+    int event_base, error_base, major, minor;
+    if (!XTestQueryExtension(injector, &event_base, &error_base, &major, &minor)) {
+        printf("ERROR: XTest extension not available on $DISPLAY\n");
+    } else {
+        podi_set_backend(PODI_BACKEND_X11);
+        result = podi_main(bench_main);
+        if (result < 0) printf("ERROR: Failed to create application\n");
+    }
+
+    XCloseDisplay(injector);
+    return result == 0 ? 0 : 1;
+}
@@ -78,16 +78,8 @@ int demo_main(podi_application *app) {
                         printf(" Modifiers: %s", modifiers_str);
                     }
 
-                    if (event.key.text && strlen(event.key.text) > 0) {
-                        printf(" Text: \"%s\"", event.key.text);
-
-                        // Add text to buffer
-                        int text_len = strlen(event.key.text);
-                        if (buffer_pos + text_len < MAX_TEXT_LENGTH - 1) {
-                            strcpy(input_buffer + buffer_pos, event.key.text);
-                            buffer_pos += text_len;
-                            printf(" -> Buffer: \"%s\"", input_buffer);
-                        }
+                    if (event.key.is_repeat) {
+                        printf(" (repeat)");
                     }
                     printf("\n");
 
@@ -107,6 +99,20 @@ int demo_main(podi_application *app) {
                     break;
                 }
 
+                case PODI_EVENT_TEXT_INPUT: {
+                    printf("TEXT_INPUT - Text: \"%s\"", event.text_input.text);
+
+                    // Add text to buffer
+                    int text_len = strlen(event.text_input.text);
+                    if (buffer_pos + text_len < MAX_TEXT_LENGTH - 1) {
+                        strcpy(input_buffer + buffer_pos, event.text_input.text);
+                        buffer_pos += text_len;
+                        printf(" -> Buffer: \"%s\"", input_buffer);
+                    }
+                    printf("\n");
+                    break;
+                }
+
                 case PODI_EVENT_KEY_UP: {
                     const char *key_name = podi_get_key_name(event.key.key);
                     const char *modifiers_str = podi_get_modifiers_string(event.key.modifiers);
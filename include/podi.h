@@ -26,6 +26,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -91,7 +92,18 @@ typedef enum {
     PODI_EVENT_MOUSE_ENTER,
 
     /** Mouse cursor left window area */
-    PODI_EVENT_MOUSE_LEAVE
+    PODI_EVENT_MOUSE_LEAVE,
+
+    /** Another thread called podi_application_post_wakeup() (window is NULL) */
+    PODI_EVENT_WAKEUP,
+
+    /** Unaccelerated relative motion while the cursor is locked in raw motion mode */
+    PODI_EVENT_MOUSE_RAW_MOTION,
+
+    /** Printable text was typed; follows the PODI_EVENT_KEY_DOWN that produced it */
+    PODI_EVENT_TEXT_INPUT,
+
+    PODI_EVENT_TYPE_COUNT     /** Number of event types (not an event) */
 } podi_event_type;
 
 /**
@@ -131,7 +143,9 @@ typedef enum {
     PODI_KEY_UP,         /** Up arrow key */
     PODI_KEY_DOWN,       /** Down arrow key */
     PODI_KEY_LEFT,       /** Left arrow key */
-    PODI_KEY_RIGHT       /** Right arrow key */
+    PODI_KEY_RIGHT,      /** Right arrow key */
+
+    PODI_KEY_COUNT       /** Number of key codes (not a key) */
 } podi_key;
 
 /**
@@ -147,6 +161,16 @@ typedef enum {
     PODI_MOUSE_BUTTON_X2           /** Extra mouse button 2 (forward) */
 } podi_mouse_button;
 
+/**
+ * @brief Bit for an event type in a window event mask
+ *
+ * Combine with | to build a mask for podi_window_set_event_mask().
+ */
+#define PODI_EVENT_MASK(type) (1u << (type))
+
+/** @brief Event mask selecting every event type */
+#define PODI_EVENT_MASK_ALL 0xFFFFFFFFu
+
 /**
  * @brief Keyboard modifier flags
  *
@@ -160,6 +184,36 @@ typedef enum {
     PODI_MOD_SUPER = 1 << 3     /** Super/Windows/Cmd key held */
 } podi_mod_flags;
 
+/**
+ * @brief Snapshot of a window's keyboard and mouse state
+ *
+ * Filled by podi_window_get_input_state(). Use the bitsets directly or
+ * podi_window_is_key_down() for single keys.
+ */
+typedef struct {
+    uint64_t keys_down[(PODI_KEY_COUNT + 63) / 64]; /** Held keys, bit n set for podi_key n */
+    uint32_t mouse_buttons;   /** Held mouse buttons, bit n set for podi_mouse_button n */
+    uint32_t modifiers;       /** Active modifier keys (podi_mod_flags) */
+    double mouse_x, mouse_y;  /** Last cursor position, as in PODI_EVENT_MOUSE_MOVE */
+} podi_input_state;
+
+/**
+ * @brief Cumulative counters describing what an application has done
+ *
+ * Filled by podi_application_get_stats(). All values count from application
+ * creation; sample them once per frame and subtract to get per-frame rates.
+ * Counters a backend does not instrument stay zero.
+ */
+typedef struct {
+    uint64_t events[PODI_EVENT_TYPE_COUNT]; /** Events translated, indexed by podi_event_type */
+    uint64_t events_dropped;  /** Events lost because an application or window queue was full */
+    uint64_t events_filtered; /** Native events consumed by the input method (XFilterEvent) */
+    uint64_t flushes;         /** Explicit XFlush / wl_display_flush calls */
+    uint64_t round_trips;     /** Blocking requests that wait for a server reply */
+    uint64_t cursor_uploads;  /** Cursor images created or attached on the server */
+    uint64_t dispatch_ns;     /** Time spent translating native events, in nanoseconds */
+} podi_application_stats;
+
 /**
  * @brief Window resize edge identifiers
  *
@@ -193,7 +247,8 @@ typedef enum {
     PODI_CURSOR_RESIZE_NE,         /** Resize cursor pointing Northeast (diagonal) */
     PODI_CURSOR_RESIZE_NW,         /** Resize cursor pointing Northwest (diagonal) */
     PODI_CURSOR_RESIZE_SE,         /** Resize cursor pointing Southeast (diagonal) */
-    PODI_CURSOR_RESIZE_SW          /** Resize cursor pointing Southwest (diagonal) */
+    PODI_CURSOR_RESIZE_SW,         /** Resize cursor pointing Southwest (diagonal) */
+    PODI_CURSOR_SHAPE_COUNT        /** Number of cursor shapes (not a shape) */
 } podi_cursor_shape;
 
 /**
@@ -209,6 +264,15 @@ typedef struct {
     /** Window that generated this event */
     podi_window *window;
 
+    /**
+     * Time the event occurred, in nanoseconds on the CLOCK_MONOTONIC clock
+     * (comparable with clock_gettime(CLOCK_MONOTONIC)). Input events use the
+     * window system's own timestamp (millisecond resolution) mapped to this
+     * clock; other events use the time they were received. On macOS the
+     * clock is CLOCK_UPTIME_RAW instead, the base of NSEvent timestamps.
+     */
+    uint64_t timestamp_ns;
+
     /** Event-specific data (check type to determine which field is valid) */
     union {
         /** Window resize event data (PODI_EVENT_WINDOW_RESIZE) */
@@ -220,8 +284,8 @@ typedef struct {
         struct {
             podi_key key;             /** Normalized key code */
             uint32_t native_keycode;  /** Platform-specific key code */
-            const char *text;         /** UTF-8 text generated (may be NULL) */
             uint32_t modifiers;       /** Active modifier keys (podi_mod_flags) */
+            bool is_repeat;           /** True for KEY_DOWN generated by holding the key */
         } key;
 
         /** Mouse button event data (PODI_EVENT_MOUSE_BUTTON_DOWN/UP) */
@@ -237,8 +301,24 @@ typedef struct {
 
         /** Mouse scroll event data (PODI_EVENT_MOUSE_SCROLL) */
         struct {
-            double x, y;              /** Scroll amounts (usually only y is used) */
+            double x, y;              /** Scroll amounts in wheel notches (positive y is up, positive x is left); fractional for smooth scrolling */
         } mouse_scroll;
+
+        /** Raw relative motion data (PODI_EVENT_MOUSE_RAW_MOTION) */
+        struct {
+            double delta_x, delta_y;  /** Unaccelerated device motion in device units */
+            uint64_t device_time_us;  /** Device timestamp in microseconds (X11: millisecond resolution) */
+        } raw_motion;
+
+        /** Text input data (PODI_EVENT_TEXT_INPUT) */
+        struct {
+            char text[32];            /** NUL-terminated UTF-8, stored in the event itself */
+        } text_input;
+
+        /** Cross-thread wakeup data (PODI_EVENT_WAKEUP) */
+        struct {
+            void *payload;            /** Pointer passed to podi_application_post_wakeup() */
+        } wakeup;
     };
 } podi_event;
 
@@ -250,7 +330,9 @@ typedef struct {
 typedef enum {
     PODI_BACKEND_AUTO = 0,    /** Automatically choose best available backend */
     PODI_BACKEND_X11,         /** Force use of X11 backend */
-    PODI_BACKEND_WAYLAND      /** Force use of Wayland backend */
+    PODI_BACKEND_WAYLAND,     /** Force use of Wayland backend */
+    PODI_BACKEND_REPLAY,      /** Replay a recorded input log without a display (Linux) */
+    PODI_BACKEND_HEADLESS     /** In-memory windows fed by podi_application_inject_event() (Linux) */
 } podi_backend_type;
 
 /**
@@ -264,6 +346,45 @@ typedef enum {
  */
 typedef int (*podi_main_func)(podi_application *app);
 
+/**
+ * @brief Event handler signature for callback dispatch mode
+ *
+ * Called directly from the backend's event translation code. The event is
+ * only valid for the duration of the call.
+ *
+ * @param app Application the event belongs to
+ * @param event Translated event (read-only, not stored anywhere)
+ * @param user_data Pointer passed to podi_application_set_event_callback()
+ */
+typedef void (*podi_event_callback)(podi_application *app, const podi_event *event, void *user_data);
+
+/**
+ * @brief Severity of a diagnostic message
+ *
+ * Lower values are more severe. A message is emitted when its level is at
+ * or below the threshold set with podi_set_log_level().
+ */
+typedef enum {
+    PODI_LOG_LEVEL_ERROR = 0,  /** A feature failed and is unavailable */
+    PODI_LOG_LEVEL_WARNING,    /** Something unexpected that podi recovered from */
+    PODI_LOG_LEVEL_INFO,       /** Backend selection and capability discovery */
+    PODI_LOG_LEVEL_DEBUG       /** Per-event detail; only present in debug builds */
+} podi_log_level;
+
+/**
+ * @brief Receiver for podi's diagnostic messages
+ *
+ * @param level Severity of the message
+ * @param message Formatted message without a trailing newline
+ * @param user_data Pointer passed to podi_set_log_callback()
+ */
+typedef void (*podi_log_callback)(podi_log_level level, const char *message, void *user_data);
+
+/**
+ * @brief Timeout value for podi_application_wait_events() that never expires
+ */
+#define PODI_WAIT_FOREVER (-1)
+
 /* =============================================================================
  * Backend Management Functions
  * ============================================================================= */
@@ -292,6 +413,32 @@ podi_backend_type podi_get_backend(void);
  */
 const char *podi_get_backend_name(void);
 
+/* =============================================================================
+ * Logging Functions
+ * ============================================================================= */
+
+/**
+ * @brief Route podi's diagnostic messages to the application
+ *
+ * By default messages go to stderr. Messages may be emitted from any thread
+ * that calls into podi; the callback must not call back into podi.
+ *
+ * @param callback Receiver for messages (NULL restores the stderr sink)
+ * @param user_data Pointer passed to every callback invocation
+ */
+void podi_set_log_callback(podi_log_callback callback, void *user_data);
+
+/**
+ * @brief Set the most verbose level that is emitted
+ *
+ * Defaults to PODI_LOG_LEVEL_WARNING, or the level named by the PODI_LOG_LEVEL
+ * environment variable ("error", "warning", "info" or "debug"). Debug
+ * messages are compiled out of release builds and cannot be enabled here.
+ *
+ * @param level Most verbose level to emit
+ */
+void podi_set_log_level(podi_log_level level);
+
 /* =============================================================================
  * Input Utility Functions
  * ============================================================================= */
@@ -385,6 +532,185 @@ void podi_application_close(podi_application *app);
  */
 bool podi_application_poll_event(podi_application *app, podi_event *event);
 
+/**
+ * @brief Poll for multiple window system events at once
+ *
+ * Fills a caller-owned array with as many pending events as are available,
+ * up to capacity. This avoids the fixed per-call overhead of
+ * podi_application_poll_event() when many events arrive per frame
+ * (e.g. high-rate mice).
+ *
+ * @param app Application instance
+ * @param events Array to fill with events (output parameter)
+ * @param capacity Number of entries available in events
+ * @return Number of events written (0 if no events are pending)
+ */
+size_t podi_application_poll_events(podi_application *app, podi_event *events, size_t capacity);
+
+/**
+ * @brief Wait for events without spinning
+ *
+ * Blocks until window system events arrive or the timeout expires, so idle
+ * applications can sleep at 0% CPU and still wake as soon as input arrives.
+ * Events read while waiting are queued; retrieve them with
+ * podi_application_poll_event() or podi_application_poll_events().
+ *
+ * @param app Application instance
+ * @param timeout_ns Maximum time to wait in nanoseconds, PODI_WAIT_FOREVER to
+ *                   wait indefinitely, or 0 to check without blocking
+ * @return true if events are ready to be polled, false if the timeout expired
+ */
+bool podi_application_wait_events(podi_application *app, int64_t timeout_ns);
+
+/**
+ * @brief Wake the event loop from another thread
+ *
+ * Queues a PODI_EVENT_WAKEUP event carrying payload and interrupts a
+ * podi_application_wait_events() call in progress. This is the only Podi
+ * function that may be called from threads other than the one running the
+ * event loop. Wakeups posted before the loop next polls are delivered in
+ * the order they were posted.
+ *
+ * @param app Application instance
+ * @param payload Caller-defined pointer returned in event->wakeup.payload (may be NULL)
+ * @return true if the wakeup was queued, false on allocation failure
+ */
+bool podi_application_post_wakeup(podi_application *app, void *payload);
+
+/**
+ * @brief Deliver events through a callback instead of the event queue
+ *
+ * While a callback is set, events are handed to it as they are translated
+ * (from podi_application_dispatch() or any of the poll functions) instead
+ * of being copied into the application queue, and motion coalescing does
+ * not apply. Windows with their own queue (podi_window_set_event_queue_enabled())
+ * keep receiving their events there. The callback must not poll, wait or
+ * dispatch on the same application.
+ *
+ * @param app Application instance
+ * @param callback Handler to invoke, or NULL to return to queued delivery
+ * @param user_data Pointer passed through to every callback invocation
+ */
+void podi_application_set_event_callback(podi_application *app, podi_event_callback callback, void *user_data);
+
+/**
+ * @brief Run the event callback for everything pending
+ *
+ * Reads whatever the display connection has available without blocking
+ * and invokes the callback set with podi_application_set_event_callback()
+ * for each event, including events queued before the callback was set.
+ * Combine with podi_application_wait_events() to sleep between batches.
+ *
+ * @param app Application instance
+ * @return Number of events passed to the callback
+ */
+size_t podi_application_dispatch(podi_application *app);
+
+/**
+ * @brief Get the file descriptor to wait on for events
+ *
+ * Lets applications that run their own event loop (epoll, io_uring, ...)
+ * watch the display connection alongside their other descriptors instead
+ * of calling podi_application_wait_events(). Wait for it to become readable
+ * between podi_application_prepare_read() and
+ * podi_application_dispatch_events(). This is an epoll descriptor that
+ * also becomes readable for podi_application_post_wakeup() and, on
+ * Wayland, client-side key repeats.
+ *
+ * @param app Application instance
+ * @return Readable file descriptor, or -1 if the backend has none
+ */
+int podi_application_get_fd(podi_application *app);
+
+/**
+ * @brief Prepare to wait on the display file descriptor
+ *
+ * Flushes outgoing requests and checks whether events are already queued.
+ * When this returns true, the caller should wait for the descriptor from
+ * podi_application_get_fd() and must then call
+ * podi_application_dispatch_events() exactly once. When it returns false,
+ * events are already available: retrieve them with
+ * podi_application_poll_event() without waiting.
+ *
+ * @param app Application instance
+ * @return true if the caller may wait on the descriptor, false if events are pending
+ */
+bool podi_application_prepare_read(podi_application *app);
+
+/**
+ * @brief Read and translate events after an external wait
+ *
+ * Completes the read started by podi_application_prepare_read() without
+ * blocking. Translated events are queued for podi_application_poll_event()
+ * and podi_application_poll_events().
+ *
+ * @param app Application instance
+ * @param fd_readable true if the descriptor was reported readable
+ * @return true on success, false if the display connection failed
+ */
+bool podi_application_dispatch_events(podi_application *app, bool fd_readable);
+
+/**
+ * @brief Send buffered requests to the display server now
+ *
+ * With deferred flushing enabled (see podi_application_set_deferred_flush()),
+ * window setters (title, size, cursor, ...) only queue their requests, and
+ * the queue is sent once at the start of the next poll, wait or
+ * prepare_read call. Call this to push them out earlier, e.g. before a
+ * long computation.
+ *
+ * @param app Application instance
+ */
+void podi_application_flush(podi_application *app);
+
+/**
+ * @brief Choose whether window setters defer their flush
+ *
+ * By default every setter sends its requests immediately, which costs one
+ * write per call. With deferred flushing, several changes in one frame
+ * cost a single write, but they only reach the server at the next
+ * poll/wait or podi_application_flush().
+ *
+ * @param app Application instance
+ * @param deferred true to batch requests until the next poll/wait or
+ *                 podi_application_flush(), false to flush after each setter
+ */
+void podi_application_set_deferred_flush(podi_application *app, bool deferred);
+
+/**
+ * @brief Limit how many events an application may queue
+ *
+ * Events are queued internally between translation and polling. The queue
+ * grows on demand up to this limit; once it is reached, new events are
+ * dropped until the application drains the queue. Backends that translate
+ * events directly into the caller's buffer are not affected.
+ *
+ * @param app Application instance
+ * @param capacity Maximum number of queued events (0 restores the default)
+ */
+void podi_application_set_event_queue_capacity(podi_application *app, size_t capacity);
+
+/**
+ * @brief Get the number of events dropped because the event queue was full
+ *
+ * @param app Application instance
+ * @return Total number of dropped events since the application was created
+ */
+uint64_t podi_application_get_dropped_event_count(podi_application *app);
+
+/**
+ * @brief Sample the application's runtime counters
+ *
+ * Cheap enough to call every frame. When the library is built with
+ * PODI_NO_STATS the counters are compiled out, stats is zeroed and false
+ * is returned.
+ *
+ * @param app Application instance
+ * @param stats Receives the counters
+ * @return true if stats were filled, false if unavailable
+ */
+bool podi_application_get_stats(podi_application *app, podi_application_stats *stats);
+
 /**
  * @brief Get the display scale factor
  *
@@ -615,6 +941,127 @@ bool podi_window_is_fullscreen_exclusive(podi_window *window);
  */
 int podi_window_get_title_bar_height(podi_window *window);
 
+/**
+ * @brief Merge consecutive mouse movement events for a window
+ *
+ * When enabled, a PODI_EVENT_MOUSE_MOVE for this window that arrives while
+ * the previous queued event is also a move for this window is folded into
+ * it: deltas are summed and the latest absolute position is kept. High-rate
+ * mice then produce roughly one move event per poll instead of one per
+ * device report. Disabled by default.
+ *
+ * @param window Window to configure
+ * @param enabled true to coalesce motion, false to report every movement
+ */
+void podi_window_set_motion_coalescing(podi_window *window, bool enabled);
+
+/**
+ * @brief Report locked-cursor motion as raw device deltas
+ *
+ * When enabled, relative motion while the cursor is locked is delivered as
+ * PODI_EVENT_MOUSE_RAW_MOTION events instead of PODI_EVENT_MOUSE_MOVE. Each
+ * event carries the unaccelerated deltas of one device report and the
+ * device timestamp, and no cursor warping or position tracking is done per
+ * event. Raw events are never coalesced. Disabled by default.
+ *
+ * The device timestamp is only meaningful relative to other raw motion
+ * timestamps; it is not on the same clock as the rest of the system.
+ *
+ * @param window Window to configure
+ * @param enabled true to receive raw motion events, false for regular move events
+ */
+void podi_window_set_raw_motion(podi_window *window, bool enabled);
+
+/**
+ * @brief Give a window its own event queue
+ *
+ * When enabled, events targeted at this window are stored in a queue owned
+ * by the window instead of the application queue, and are retrieved with
+ * podi_window_poll_event() or podi_window_poll_events(). This lets one
+ * thread per window consume its own events without filtering the shared
+ * stream. The application thread must keep calling
+ * podi_application_poll_event(), podi_application_poll_events() or
+ * podi_application_dispatch_events() to read events from the display; those
+ * calls then only return events that belong to no window-owned queue.
+ *
+ * Call this from the application thread, before other threads start
+ * polling the window. Disabling discards events still in the window queue.
+ *
+ * @param window Window to configure
+ * @param enabled true to route this window's events to its own queue
+ */
+void podi_window_set_event_queue_enabled(podi_window *window, bool enabled);
+
+/**
+ * @brief Choose which event types a window receives
+ *
+ * Events whose type is not in the mask are dropped before they are queued
+ * or passed to a callback. Where the window system allows it, they are not
+ * requested from the server at all (on X11 the window's XSelectInput mask
+ * is reduced), which saves both traffic and translation work. Window
+ * state tracking (focus, size, cursor lock) continues internally
+ * regardless of the mask. The default mask is PODI_EVENT_MASK_ALL.
+ *
+ * @param window Window to configure
+ * @param mask Combination of PODI_EVENT_MASK(type) bits
+ */
+void podi_window_set_event_mask(podi_window *window, uint32_t mask);
+
+/**
+ * @brief Poll for the next event targeted at a window
+ *
+ * Only returns events while the window's own queue is enabled with
+ * podi_window_set_event_queue_enabled(). Safe to call from a thread other
+ * than the application thread; each window queue has its own lock, so
+ * threads polling different windows do not contend.
+ *
+ * @param window Window to poll
+ * @param event Pointer to event structure to fill (output parameter)
+ * @return true if an event was retrieved, false if none are pending
+ */
+bool podi_window_poll_event(podi_window *window, podi_event *event);
+
+/**
+ * @brief Poll for multiple events targeted at a window at once
+ *
+ * Batched variant of podi_window_poll_event() with the same threading rules.
+ *
+ * @param window Window to poll
+ * @param events Array to fill with events (output parameter)
+ * @param capacity Number of entries available in events
+ * @return Number of events written (0 if none are pending)
+ */
+size_t podi_window_poll_events(podi_window *window, podi_event *events, size_t capacity);
+
+/**
+ * @brief Check whether a key is currently held in a window
+ *
+ * Answers from a bitset maintained as events are translated, so it is
+ * cheap enough to call many times per frame and reflects events that have
+ * been read from the window system even if they are still queued. Held
+ * keys are released when the window loses focus. Events masked out with
+ * podi_window_set_event_mask() still update the state; only when every
+ * key event type is masked out (so none are requested from the window
+ * system) are keys no longer tracked.
+ *
+ * @param window Window to query
+ * @param key Key to check
+ * @return true if the key is down
+ */
+bool podi_window_is_key_down(podi_window *window, podi_key key);
+
+/**
+ * @brief Copy a window's current keyboard and mouse state
+ *
+ * Same source and rules as podi_window_is_key_down(). The snapshot is
+ * consistent and may be taken from any thread without blocking the
+ * thread that processes events.
+ *
+ * @param window Window to query
+ * @param state Receives the snapshot (zeroed if window is NULL)
+ */
+void podi_window_get_input_state(podi_window *window, podi_input_state *state);
+
 #ifdef PODI_PLATFORM_LINUX
 /* =============================================================================
  * Platform-Specific Linux Functions
@@ -665,6 +1112,63 @@ bool podi_window_get_x11_handles(podi_window *window, podi_x11_handles *handles)
  * @return true if handles were retrieved (Wayland backend), false otherwise
  */
 bool podi_window_get_wayland_handles(podi_window *window, podi_wayland_handles *handles);
+
+/**
+ * @brief Start writing every translated event to a binary log
+ *
+ * Each event is recorded with its timestamp as it leaves the backend,
+ * before window event masks are applied. The log is a fixed-size header
+ * followed by fixed-size records, so it can be mapped and indexed
+ * directly; it is only readable by builds with the same podi_event layout.
+ * Windows are stored by creation order, which closing other windows does
+ * not change.
+ * A recording already in progress is stopped first.
+ *
+ * @param app Application to record
+ * @param path File to create or truncate
+ * @return true if the file was opened and recording started
+ */
+bool podi_application_start_recording(podi_application *app, const char *path);
+
+/**
+ * @brief Stop recording and close the log file
+ *
+ * Called automatically by podi_application_destroy().
+ *
+ * @param app Application being recorded
+ */
+void podi_application_stop_recording(podi_application *app);
+
+/**
+ * @brief Replay a recorded log instead of connecting to a display
+ *
+ * Selects PODI_BACKEND_REPLAY; call before podi_application_create(). The
+ * replay backend's windows exist only in memory and receive the recorded
+ * events in the order the application creates them. Once the log is
+ * exhausted and the queue drained, podi_application_should_close()
+ * returns true. Without this call the backend reads PODI_REPLAY_FILE and
+ * PODI_REPLAY_SPEED from the environment (PODI_BACKEND=replay).
+ *
+ * @param path Log written by podi_application_start_recording()
+ * @param speed Playback rate relative to the recording (1.0 = recorded
+ *              timing), or 0 to deliver events as fast as they are polled
+ */
+void podi_set_replay_source(const char *path, double speed);
+
+/**
+ * @brief Deliver a synthetic event as if the backend had translated it
+ *
+ * The event goes through the same path as real input: window event masks,
+ * motion coalescing, per-window queues, the event callback, recording and
+ * the input state snapshot. A zero timestamp_ns is replaced with the
+ * current time. This is how PODI_BACKEND_HEADLESS receives input, but it
+ * works with any backend. Call it from the thread that polls events.
+ *
+ * @param app Application to deliver to
+ * @param event Event to deliver (window may be NULL or one of app's windows)
+ * @return true if the event was queued or handled, false if it was dropped
+ */
+bool podi_application_inject_event(podi_application *app, const podi_event *event);
 #endif
 
 /* =============================================================================
@@ -0,0 +1,319 @@
+#define _GNU_SOURCE
+#include "internal.h"
+#include "podi.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef struct {
+    podi_application_common common;
+} podi_application_headless;
+
+typedef struct {
+    podi_window_common common;
+    podi_application_common *app;
+} podi_window_headless;
+
+static void headless_application_destroy(podi_application *app_generic);
+
+static podi_application *headless_application_create(void) {
+    podi_application_headless *app = calloc(1, sizeof(podi_application_headless));
+    if (!app) return NULL;
+
+    if (!podi_wakeup_init(&app->common.wakeup)) {
+        free(app);
+        return NULL;
+    }
+
+    return (podi_application *)app;
+}
+
+static void headless_application_destroy(podi_application *app_generic) {
+    podi_application_headless *app = (podi_application_headless *)app_generic;
+    if (!app) return;
+
+    while (app->common.window_count > 0) {
+        podi_window_destroy(app->common.windows[app->common.window_count - 1]);
+    }
+    free(app->common.windows);
+    podi_event_queue_free(&app->common.events);
+    podi_wakeup_destroy(&app->common.wakeup);
+    free(app);
+}
+
+bool headless_application_should_close(podi_application *app_generic) {
+    podi_application_common *app = (podi_application_common *)app_generic;
+    return app ? app->should_close : true;
+}
+
+void headless_application_close(podi_application *app_generic) {
+    podi_application_common *app = (podi_application_common *)app_generic;
+    if (app) app->should_close = true;
+}
+
+// Events only come from podi_application_inject_event() and wakeups, both
+// of which are already in the queue by the time it is polled
+static bool headless_application_poll_event(podi_application *app_generic, podi_event *event) {
+    podi_application_headless *app = (podi_application_headless *)app_generic;
+    if (!app || !event) return false;
+
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    return podi_event_queue_pop(&app->common.events, event);
+}
+
+static size_t headless_application_poll_events(podi_application *app_generic, podi_event *events, size_t capacity) {
+    podi_application_headless *app = (podi_application_headless *)app_generic;
+    if (!app || !events || capacity == 0) return 0;
+
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    return podi_event_queue_pop_many(&app->common.events, events, capacity);
+}
+
+static bool headless_application_wait_events(podi_application *app_generic, int64_t timeout_ns) {
+    podi_application_headless *app = (podi_application_headless *)app_generic;
+    if (!app) return false;
+
+    uint64_t delivered = app->common.delivered_count;
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    if (podi_application_has_events(&app->common, delivered)) return true;
+
+    // Only another thread can produce events while this one sleeps
+    struct pollfd pfd = { .fd = app->common.wakeup.fd, .events = POLLIN };
+    if (podi_poll(&pfd, 1, timeout_ns) > 0) {
+        podi_wakeup_acknowledge(&app->common.wakeup);
+    }
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    return podi_application_has_events(&app->common, delivered);
+}
+
+// Only wakeups arrive from outside, so their eventfd is all an external
+// event loop needs to watch
+static int headless_application_get_fd(podi_application *app_generic) {
+    podi_application_headless *app = (podi_application_headless *)app_generic;
+    if (!app) return -1;
+    return app->common.wakeup.fd;
+}
+
+static bool headless_application_prepare_read(podi_application *app_generic) {
+    podi_application_headless *app = (podi_application_headless *)app_generic;
+    if (!app) return false;
+
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    return app->common.events.count == 0;
+}
+
+// Injected events already went to the callback; only wakeups are left
+static bool headless_application_dispatch_events(podi_application *app_generic, bool fd_readable) {
+    podi_application_headless *app = (podi_application_headless *)app_generic;
+    if (!app) return false;
+
+    if (fd_readable) {
+        podi_wakeup_acknowledge(&app->common.wakeup);
+    }
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    return true;
+}
+
+float headless_get_display_scale_factor(podi_application *app_generic) {
+    (void)app_generic;
+    return 1.0f;
+}
+
+podi_window *headless_window_create(podi_application *app_generic, const char *title, int width, int height) {
+    podi_application_common *app = (podi_application_common *)app_generic;
+    if (!app) return NULL;
+
+    podi_window_headless *window = calloc(1, sizeof(podi_window_headless));
+    if (!window) return NULL;
+
+    window->app = app;
+    window->common.width = width;
+    window->common.height = height;
+    window->common.min_width = width;
+    window->common.min_height = height;
+    window->common.scale_factor = 1.0f;
+    window->common.title = strdup(title ? title : "Podi Window");
+    window->common.resize_edge = PODI_RESIZE_EDGE_NONE;
+    window->common.resize_border_width = 8;
+    window->common.cursor_visible = true;
+    window->common.restore_width = width;
+    window->common.restore_height = height;
+
+    if (app->window_count >= app->window_capacity) {
+        size_t new_capacity = app->window_capacity ? app->window_capacity * 2 : 4;
+        podi_window **new_windows = realloc(app->windows, new_capacity * sizeof(podi_window *));
+        if (!new_windows) {
+            free(window->common.title);
+            free(window);
+            return NULL;
+        }
+        app->windows = new_windows;
+        app->window_capacity = new_capacity;
+    }
+
+    window->common.id = app->next_window_id++;
+    app->windows[app->window_count++] = (podi_window *)window;
+    return (podi_window *)window;
+}
+
+void headless_window_destroy(podi_window *window_generic) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (!window) return;
+
+    podi_application_common *app = window->app;
+    for (size_t i = 0; i < app->window_count; i++) {
+        if (app->windows[i] == window_generic) {
+            memmove(&app->windows[i], &app->windows[i + 1],
+                   (app->window_count - i - 1) * sizeof(podi_window *));
+            app->window_count--;
+            break;
+        }
+    }
+
+    free(window->common.title);
+    free(window);
+}
+
+void headless_window_close(podi_window *window_generic) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (window) window->common.should_close = true;
+}
+
+void headless_window_set_title(podi_window *window_generic, const char *title) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (!window || !title) return;
+
+    free(window->common.title);
+    window->common.title = strdup(title);
+}
+
+void headless_window_set_size(podi_window *window_generic, int width, int height) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (!window) return;
+
+    window->common.width = width;
+    window->common.height = height;
+}
+
+void headless_window_set_position_and_size(podi_window *window_generic, int x, int y, int width, int height) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (!window) return;
+
+    window->common.x = x;
+    window->common.y = y;
+    window->common.width = width;
+    window->common.height = height;
+}
+
+void headless_window_get_size(podi_window *window_generic, int *width, int *height) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (!window) return;
+
+    if (width) *width = window->common.width;
+    if (height) *height = window->common.height;
+}
+
+float headless_window_get_scale_factor(podi_window *window_generic) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    return window ? window->common.scale_factor : 1.0f;
+}
+
+bool headless_window_should_close(podi_window *window_generic) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    return window ? window->common.should_close : true;
+}
+
+void headless_window_begin_interactive_resize(podi_window *window_generic, int edge) {
+    (void)window_generic;
+    (void)edge;
+}
+
+void headless_window_begin_move(podi_window *window_generic) {
+    (void)window_generic;
+}
+
+void headless_window_set_cursor(podi_window *window_generic, podi_cursor_shape cursor) {
+    (void)window_generic;
+    (void)cursor;
+}
+
+void headless_window_set_cursor_mode(podi_window *window_generic, bool locked, bool visible) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (!window) return;
+
+    window->common.cursor_locked = locked;
+    window->common.cursor_visible = visible;
+}
+
+void headless_window_get_cursor_position(podi_window *window_generic, double *x, double *y) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (!window || !x || !y) return;
+
+    // There is no pointer to query; report the last delivered motion
+    podi_input_state state;
+    podi_window_get_input_state(window_generic, &state);
+    *x = state.mouse_x;
+    *y = state.mouse_y;
+}
+
+void headless_window_set_fullscreen_exclusive(podi_window *window_generic, bool enabled) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    if (window) window->common.fullscreen_exclusive = enabled;
+}
+
+bool headless_window_is_fullscreen_exclusive(podi_window *window_generic) {
+    podi_window_headless *window = (podi_window_headless *)window_generic;
+    return window ? window->common.fullscreen_exclusive : false;
+}
+
+int headless_window_get_title_bar_height(podi_window *window_generic) {
+    (void)window_generic;
+    return 0;
+}
+
+bool headless_window_get_x11_handles(podi_window *window_generic, podi_x11_handles *handles) {
+    (void)window_generic;
+    (void)handles;
+    return false;
+}
+
+bool headless_window_get_wayland_handles(podi_window *window_generic, podi_wayland_handles *handles) {
+    (void)window_generic;
+    (void)handles;
+    return false;
+}
+
+const podi_platform_vtable headless_vtable = {
+    .application_create = headless_application_create,
+    .application_destroy = headless_application_destroy,
+    .application_should_close = headless_application_should_close,
+    .application_close = headless_application_close,
+    .application_poll_event = headless_application_poll_event,
+    .application_poll_events = headless_application_poll_events,
+    .application_wait_events = headless_application_wait_events,
+    .application_get_fd = headless_application_get_fd,
+    .application_prepare_read = headless_application_prepare_read,
+    .application_dispatch_events = headless_application_dispatch_events,
+    .get_display_scale_factor = headless_get_display_scale_factor,
+    .window_create = headless_window_create,
+    .window_destroy = headless_window_destroy,
+    .window_close = headless_window_close,
+    .window_set_title = headless_window_set_title,
+    .window_set_size = headless_window_set_size,
+    .window_set_position_and_size = headless_window_set_position_and_size,
+    .window_get_size = headless_window_get_size,
+    .window_get_framebuffer_size = headless_window_get_size,
+    .window_get_surface_size = headless_window_get_size,
+    .window_get_scale_factor = headless_window_get_scale_factor,
+    .window_should_close = headless_window_should_close,
+    .window_begin_interactive_resize = headless_window_begin_interactive_resize,
+    .window_begin_move = headless_window_begin_move,
+    .window_set_cursor = headless_window_set_cursor,
+    .window_set_cursor_mode = headless_window_set_cursor_mode,
+    .window_get_cursor_position = headless_window_get_cursor_position,
+    .window_set_fullscreen_exclusive = headless_window_set_fullscreen_exclusive,
+    .window_is_fullscreen_exclusive = headless_window_is_fullscreen_exclusive,
+    .window_get_title_bar_height = headless_window_get_title_bar_height,
+    .window_get_x11_handles = headless_window_get_x11_handles,
+    .window_get_wayland_handles = headless_window_get_wayland_handles,
+};
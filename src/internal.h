@@ -14,6 +14,12 @@
 
 #include "podi.h"
 #include <stddef.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#ifdef PODI_PLATFORM_LINUX
+#include <poll.h>
+#endif
 
 /* =============================================================================
  * Constants and Configuration
@@ -28,6 +34,41 @@
  */
 #define PODI_TITLE_BAR_HEIGHT 30
 
+/**
+ * @brief Initial number of slots allocated for an application event queue
+ *
+ * The queue doubles in size whenever it fills up, until it reaches its limit.
+ */
+#define PODI_EVENT_QUEUE_INITIAL_CAPACITY 64
+
+/**
+ * @brief Default maximum number of events held in an application event queue
+ *
+ * Once this many events are pending, further events are dropped and counted
+ * until the application drains the queue. Can be changed per application
+ * with podi_application_set_event_queue_capacity().
+ */
+#define PODI_EVENT_QUEUE_DEFAULT_LIMIT 65536
+
+/**
+ * @brief Runtime counter updates for podi_application_get_stats()
+ *
+ * Backends bump counters through these macros so a build with PODI_NO_STATS
+ * removes every instrumentation point. app is a podi_application_common
+ * pointer and field a podi_application_stats member. The timer macros are
+ * only usable where podi_time_now_ns() exists (Linux).
+ */
+#ifndef PODI_NO_STATS
+#define PODI_STAT_ADD(app, field, n) ((app)->stats.field += (n))
+#define PODI_STAT_TIMER_START(name) uint64_t name = podi_time_now_ns()
+#define PODI_STAT_TIMER_STOP(app, field, name) PODI_STAT_ADD(app, field, podi_time_now_ns() - (name))
+#else
+#define PODI_STAT_ADD(app, field, n) ((void)0)
+#define PODI_STAT_TIMER_START(name) ((void)0)
+#define PODI_STAT_TIMER_STOP(app, field, name) ((void)0)
+#endif
+#define PODI_STAT_INC(app, field) PODI_STAT_ADD(app, field, 1)
+
 /* =============================================================================
  * Platform Abstraction Layer
  * ============================================================================= */
@@ -103,6 +144,81 @@ typedef struct podi_platform_vtable {
      */
     bool (*application_poll_event)(podi_application *app, podi_event *event);
 
+    /**
+     * @brief Drain available events into a caller-owned array
+     *
+     * Batched variant of application_poll_event. Per-poll work (cursor lock
+     * maintenance, socket reads) is done once per call instead of once per
+     * event. Optional: when NULL, the common layer falls back to calling
+     * application_poll_event repeatedly.
+     *
+     * @param app Application instance to poll events for
+     * @param events Output: Array to fill with translated events
+     * @param capacity Number of entries available in events
+     * @return Number of events written to events
+     */
+    size_t (*application_poll_events)(podi_application *app, podi_event *events, size_t capacity);
+
+    /**
+     * @brief Block until events arrive or a timeout expires
+     *
+     * Sleeps on the display connection without spinning. Events read while
+     * waiting are translated and queued for the next poll. Optional: when
+     * NULL, the common layer returns immediately.
+     *
+     * @param app Application instance to wait on
+     * @param timeout_ns Maximum time to wait in nanoseconds (negative = forever, 0 = don't block)
+     * @return true if events are ready to be polled, false on timeout or error
+     */
+    bool (*application_wait_events)(podi_application *app, int64_t timeout_ns);
+
+    /**
+     * @brief Get the display connection's file descriptor
+     *
+     * Optional: when NULL, the common layer returns -1.
+     *
+     * @param app Application instance to query
+     * @return File descriptor that becomes readable when events arrive
+     */
+    int (*application_get_fd)(podi_application *app);
+
+    /**
+     * @brief Prepare for an external wait on the display descriptor
+     *
+     * Flushes requests and reports whether the caller may block on the
+     * descriptor. A successful prepare must be followed by exactly one
+     * application_dispatch_events call. Optional: when NULL, the common
+     * layer returns false so callers fall back to polling.
+     *
+     * @param app Application instance to prepare
+     * @return true if the caller may wait, false if events are already queued
+     */
+    bool (*application_prepare_read)(podi_application *app);
+
+    /**
+     * @brief Read and translate events without blocking
+     *
+     * Completes (or cancels) the read started by application_prepare_read
+     * and queues translated events in the common event queue. Optional:
+     * when NULL, the common layer does nothing.
+     *
+     * @param app Application instance to dispatch for
+     * @param fd_readable true if the descriptor was reported readable
+     * @return true on success, false if the display connection failed
+     */
+    bool (*application_dispatch_events)(podi_application *app, bool fd_readable);
+
+    /**
+     * @brief Send all buffered requests to the display server
+     *
+     * Backends defer the flush after setters and send pending requests at
+     * the start of their poll and wait functions; this sends them now.
+     * Optional: when NULL, the common layer does nothing.
+     *
+     * @param app Application instance to flush
+     */
+    void (*application_flush)(podi_application *app);
+
     /**
      * @brief Get the platform's display scale factor
      *
@@ -354,6 +470,18 @@ typedef struct podi_platform_vtable {
      */
     int (*window_get_title_bar_height)(podi_window *window);
 
+    /**
+     * @brief Apply a new event mask to the window system subscription
+     *
+     * Called after the common layer has stored the mask in
+     * podi_window_common.ignored_events, so backends can stop requesting
+     * unwanted events from the server. Optional: when NULL, unwanted events
+     * are only filtered in the common layer.
+     *
+     * @param window Window whose mask changed
+     */
+    void (*window_set_event_mask)(podi_window *window);
+
 #ifdef PODI_PLATFORM_LINUX
     /* Platform-specific handle retrieval */
 
@@ -398,6 +526,64 @@ extern const podi_platform_vtable *podi_platform;
  * Internal Data Structures
  * ============================================================================= */
 
+/**
+ * @brief Growable ring buffer of translated events
+ *
+ * Push and pop are O(1); the buffer doubles when full until it reaches
+ * its limit, after which new events are dropped and counted. The capacity
+ * is always a power of two so indices wrap with a mask.
+ */
+typedef struct {
+    /** Event storage (capacity slots, NULL until the first push) */
+    podi_event *events;
+
+    /** Number of allocated slots (power of two) */
+    size_t capacity;
+
+    /** Index of the oldest queued event */
+    size_t head;
+
+    /** Number of queued events */
+    size_t count;
+
+    /** Maximum number of queued events (0 = PODI_EVENT_QUEUE_DEFAULT_LIMIT) */
+    size_t limit;
+
+    /** Number of events discarded because the queue was full */
+    uint64_t dropped;
+} podi_event_queue;
+
+#ifdef PODI_PLATFORM_LINUX
+/**
+ * @brief Cross-thread wakeup channel
+ *
+ * Other threads append payloads under the mutex and signal the eventfd,
+ * which the backends include in the poll set of their wait path. The event
+ * loop moves posted payloads into the event queue as PODI_EVENT_WAKEUP
+ * events. The pending flag lets the poll path skip the mutex when nothing
+ * was posted.
+ */
+typedef struct {
+    /** eventfd signalled by podi_wakeup_post() */
+    int fd;
+
+    /** Set by posting threads, cleared when the loop takes the payloads */
+    atomic_bool pending;
+
+    /** Protects the payload array */
+    pthread_mutex_t lock;
+
+    /** Payloads posted since the last drain, oldest first */
+    void **payloads;
+
+    /** Number of posted payloads */
+    size_t count;
+
+    /** Allocated capacity of payloads array */
+    size_t capacity;
+} podi_wakeup;
+#endif
+
 /**
  * @brief Common application state shared across platforms
  *
@@ -417,8 +603,90 @@ typedef struct {
 
     /** Allocated capacity of windows array */
     size_t window_capacity;
+
+    /** Translated events waiting to be returned by the poll functions */
+    podi_event_queue events;
+
+    /** Handler that receives events instead of the queue (NULL = queued delivery) */
+    podi_event_callback event_callback;
+
+    /** User pointer passed to event_callback */
+    void *event_callback_user_data;
+
+    /** Number of events passed to event_callback so far */
+    size_t event_callback_count;
+
+    /** Id given to the next window created, see podi_window_common.id */
+    uint32_t next_window_id;
+
+    /** Events handed to a queue or the callback so far; lets waits notice
+     *  deliveries that never reach the application queue */
+    uint64_t delivered_count;
+
+    /** A setter queued requests that have not been flushed yet */
+    bool flush_pending;
+
+    /** Setters defer their flush to the next poll/wait (opt-in) */
+    bool flush_deferred;
+
+#ifndef PODI_NO_STATS
+    /** Counters reported by podi_application_get_stats() */
+    podi_application_stats stats;
+#endif
+
+#ifdef PODI_PLATFORM_LINUX
+    /** Wakeups posted by other threads */
+    podi_wakeup wakeup;
+
+    /** Event log written by podi_application_start_recording() (NULL = not recording) */
+    FILE *recording;
+#endif
 } podi_application_common;
 
+/* =============================================================================
+ * Event Recording Format
+ * ============================================================================= */
+
+/** @brief Magic bytes at the start of every event log */
+#define PODI_RECORDING_MAGIC "PODIREC1"
+
+/** @brief Log format version, bumped when the layout changes */
+#define PODI_RECORDING_VERSION 2u
+
+/** @brief window_id of events that have no target window */
+#define PODI_RECORDING_NO_WINDOW 0xFFFFFFFFu
+
+/**
+ * @brief Header at the start of an event log
+ *
+ * Followed directly by fixed-size podi_recorded_event entries; their count
+ * is derived from the file size.
+ */
+typedef struct {
+    /** PODI_RECORDING_MAGIC without the terminating NUL */
+    char magic[8];
+
+    /** PODI_RECORDING_VERSION of the writer */
+    uint32_t version;
+
+    /** sizeof(podi_recorded_event) of the writer, rejects other ABIs */
+    uint32_t record_size;
+} podi_recording_header;
+
+/**
+ * @brief One recorded event
+ */
+typedef struct {
+    /** podi_window_common.id of the target window, or PODI_RECORDING_NO_WINDOW */
+    uint32_t window_id;
+
+    /** Padding so the event stays 8-byte aligned in a mapped log */
+    uint32_t reserved;
+
+    /** The event as translated, with window cleared */
+    podi_event event;
+} podi_recorded_event;
+
 /**
  * @brief Common window state shared across platforms
  *
@@ -436,6 +704,9 @@ typedef struct {
     /** Window title (UTF-8 encoded, dynamically allocated) */
     char *title;
 
+    /** Creation-order id within the application, kept when other windows close */
+    uint32_t id;
+
     /* Window dimensions and positioning */
     /** Total window width including decorations (pixels) */
     int width, height;
@@ -500,6 +771,35 @@ typedef struct {
     /** Windowed mode geometry to restore when exiting fullscreen */
     int restore_x, restore_y;
     int restore_width, restore_height;
+
+    /* Event delivery options */
+    /** True if consecutive mouse move events are merged before queueing */
+    bool coalesce_motion;
+
+    /** True if locked-cursor motion is reported as unaccelerated raw events */
+    bool raw_motion;
+
+    /** Event types this window does not want (PODI_EVENT_MASK bits, 0 = receive all) */
+    uint32_t ignored_events;
+
+    /** True if this window's events go to its own queue instead of the application's */
+    bool has_event_queue;
+
+    /** True once events_lock has been initialized */
+    bool events_lock_initialized;
+
+    /** Events for this window when has_event_queue is set (guarded by events_lock) */
+    podi_event_queue events;
+
+    /** Protects events against concurrent polling threads */
+    pthread_mutex_t events_lock;
+
+    /* Input state snapshot */
+    /** Seqlock counter for input_state: odd while the event thread is writing */
+    atomic_uint input_sequence;
+
+    /** Held keys, buttons and cursor position as of the last translated event */
+    podi_input_state input_state;
 } podi_window_common;
 
 /* =============================================================================
@@ -523,6 +823,304 @@ void podi_init_platform(void);
  */
 void podi_cleanup_platform(void);
 
+#ifdef PODI_PLATFORM_LINUX
+/* =============================================================================
+ * Linux Event Loop Helpers
+ * ============================================================================= */
+
+/**
+ * @brief Mapping from a display server's millisecond clock to the monotonic clock
+ *
+ * X11 and Wayland timestamp input with a wrapping 32-bit millisecond
+ * counter whose base is not specified; Wayland relative pointer events
+ * use a 64-bit microsecond one. The offset to CLOCK_MONOTONIC is
+ * estimated from the smallest observed receive delay, so it converges on
+ * the true offset as events arrive.
+ */
+typedef struct {
+    /** Estimated monotonic time of server time zero, in nanoseconds */
+    int64_t offset_ns;
+
+    /** Server time of the previous millisecond sample, for wraparound detection */
+    uint32_t last_ms;
+
+    /** Accumulated wraparounds of the 32-bit server clock, in milliseconds */
+    uint64_t epoch_ms;
+
+    /** Server time of the previous sample in nanoseconds, for jump detection */
+    int64_t last_server_ns;
+
+    /** Monotonic time the previous sample was taken */
+    uint64_t last_local_ns;
+
+    /** True once at least one sample has been taken */
+    bool valid;
+} podi_clock_sync;
+
+/**
+ * @brief Read the monotonic clock
+ *
+ * @return Current CLOCK_MONOTONIC time in nanoseconds
+ */
+uint64_t podi_time_now_ns(void);
+
+/**
+ * @brief poll() with a nanosecond timeout
+ *
+ * Waits until one of the descriptors is ready or the timeout expires,
+ * restarting with the remaining time if interrupted by a signal.
+ *
+ * @param fds Descriptors to wait on
+ * @param count Number of entries in fds
+ * @param timeout_ns Maximum time to wait in nanoseconds (negative = forever, 0 = don't block)
+ * @return Number of ready descriptors, 0 on timeout, -1 on error
+ */
+int podi_poll(struct pollfd *fds, size_t count, int64_t timeout_ns);
+
+/**
+ * @brief Create an epoll descriptor watching several descriptors for input
+ *
+ * Level-triggered, so it stays readable while any member is. Backends
+ * return it from application_get_fd so external event loops wake for
+ * every source the backend polls internally.
+ *
+ * @param fds Descriptors to watch
+ * @param count Number of entries in fds
+ * @return epoll descriptor (close-on-exec), or -1 on error
+ */
+int podi_epoll_create(const int *fds, size_t count);
+
+/**
+ * @brief Convert a display server timestamp to monotonic nanoseconds
+ *
+ * Updates the clock mapping with the new sample and returns the server
+ * time expressed on the CLOCK_MONOTONIC clock, never later than now.
+ *
+ * @param sync Per-connection clock mapping (zero-initialized before first use)
+ * @param server_ms Server timestamp in milliseconds
+ * @return Event time in monotonic nanoseconds
+ */
+uint64_t podi_clock_sync_convert(podi_clock_sync *sync, uint32_t server_ms);
+
+/**
+ * @brief Convert a 64-bit microsecond timestamp to monotonic nanoseconds
+ *
+ * For high-resolution clocks such as the one in relative pointer events.
+ * Keep a separate mapping per clock: the base may differ from the
+ * millisecond input timestamps, and mixing samples would spoil both.
+ *
+ * @param sync Clock mapping used only for this clock (zero-initialized before first use)
+ * @param server_us Server timestamp in microseconds
+ * @return Event time in monotonic nanoseconds
+ */
+uint64_t podi_clock_sync_convert_us(podi_clock_sync *sync, uint64_t server_us);
+
+/**
+ * @brief Create the eventfd and lock of a wakeup channel
+ *
+ * @param wakeup Channel to initialize
+ * @return true on success, false if the eventfd could not be created
+ */
+bool podi_wakeup_init(podi_wakeup *wakeup);
+
+/**
+ * @brief Close a wakeup channel and free undelivered payloads storage
+ *
+ * @param wakeup Channel to destroy
+ */
+void podi_wakeup_destroy(podi_wakeup *wakeup);
+
+/**
+ * @brief Record a payload and signal the eventfd (thread-safe)
+ *
+ * @param wakeup Channel to post to
+ * @param payload Caller-defined pointer to deliver
+ * @return true if the payload was recorded, false on allocation failure
+ */
+bool podi_wakeup_post(podi_wakeup *wakeup, void *payload);
+
+/**
+ * @brief Reset the eventfd after poll() reported it readable
+ *
+ * @param wakeup Channel whose eventfd became readable
+ */
+void podi_wakeup_acknowledge(podi_wakeup *wakeup);
+
+/**
+ * @brief Deliver posted payloads as PODI_EVENT_WAKEUP events
+ *
+ * Goes through podi_application_push_event(), so wakeups are counted,
+ * recorded and passed to the callback like any other event. Cheap when
+ * nothing was posted: only an atomic load is performed. Payloads that do
+ * not fit in the application queue stay posted for the next drain.
+ *
+ * @param wakeup Channel to drain
+ * @param app Application to deliver the wakeup events to
+ */
+void podi_wakeup_drain(podi_wakeup *wakeup, podi_application_common *app);
+
+/* =============================================================================
+ * In-Memory Windows (headless.c)
+ * =============================================================================
+ *
+ * Vtable entries for windows that exist only as podi_window_common state,
+ * shared by the headless and replay backends. Geometry, title, cursor mode
+ * and fullscreen flags are stored and read back; operations that need a
+ * window system (interactive move/resize, cursor shapes, native handles)
+ * do nothing.
+ */
+
+bool headless_application_should_close(podi_application *app);
+void headless_application_close(podi_application *app);
+float headless_get_display_scale_factor(podi_application *app);
+podi_window *headless_window_create(podi_application *app, const char *title, int width, int height);
+void headless_window_destroy(podi_window *window);
+void headless_window_close(podi_window *window);
+void headless_window_set_title(podi_window *window, const char *title);
+void headless_window_set_size(podi_window *window, int width, int height);
+void headless_window_set_position_and_size(podi_window *window, int x, int y, int width, int height);
+void headless_window_get_size(podi_window *window, int *width, int *height);
+float headless_window_get_scale_factor(podi_window *window);
+bool headless_window_should_close(podi_window *window);
+void headless_window_begin_interactive_resize(podi_window *window, int edge);
+void headless_window_begin_move(podi_window *window);
+void headless_window_set_cursor(podi_window *window, podi_cursor_shape cursor);
+void headless_window_set_cursor_mode(podi_window *window, bool locked, bool visible);
+void headless_window_get_cursor_position(podi_window *window, double *x, double *y);
+void headless_window_set_fullscreen_exclusive(podi_window *window, bool enabled);
+bool headless_window_is_fullscreen_exclusive(podi_window *window);
+int headless_window_get_title_bar_height(podi_window *window);
+bool headless_window_get_x11_handles(podi_window *window, podi_x11_handles *handles);
+bool headless_window_get_wayland_handles(podi_window *window, podi_wayland_handles *handles);
+#endif
+
+/* =============================================================================
+ * Event Queue Functions
+ * ============================================================================= */
+
+/**
+ * @brief Append an event to the back of a queue
+ *
+ * Grows the queue if needed. If the queue is at its limit or cannot grow,
+ * the event is dropped and the queue's dropped counter is incremented.
+ *
+ * @param queue Queue to append to
+ * @param event Event to copy into the queue
+ * @return true if the event was queued, false if it was dropped
+ */
+bool podi_event_queue_push(podi_event_queue *queue, const podi_event *event);
+
+/**
+ * @brief Check whether a queue is at its limit
+ *
+ * @param queue Queue to check
+ * @param reserved Events the caller is about to push on top of the current ones
+ * @return true if pushing one more event beyond reserved would be dropped
+ */
+bool podi_event_queue_is_full(const podi_event_queue *queue, size_t reserved);
+
+/**
+ * @brief Remove the oldest event from a queue
+ *
+ * @param queue Queue to pop from
+ * @param event Output: Receives the oldest event
+ * @return true if an event was returned, false if the queue was empty
+ */
+bool podi_event_queue_pop(podi_event_queue *queue, podi_event *event);
+
+/**
+ * @brief Remove up to capacity of the oldest events from a queue
+ *
+ * Copies events out with at most two contiguous copies.
+ *
+ * @param queue Queue to pop from
+ * @param events Output: Array to receive the events in order
+ * @param capacity Number of entries available in events
+ * @return Number of events copied into events
+ */
+size_t podi_event_queue_pop_many(podi_event_queue *queue, podi_event *events, size_t capacity);
+
+/**
+ * @brief Get the most recently queued event
+ *
+ * @param queue Queue to inspect
+ * @return Pointer to the newest event (valid until the next push or pop), or NULL if empty
+ */
+podi_event *podi_event_queue_back(podi_event_queue *queue);
+
+/**
+ * @brief Release the storage owned by a queue
+ *
+ * The queue is left empty and may be reused.
+ *
+ * @param queue Queue to free
+ */
+void podi_event_queue_free(podi_event_queue *queue);
+
+/**
+ * @brief Deliver a translated event to the application's event queue
+ *
+ * Common entry point for backends. Applies per-window delivery options
+ * such as motion coalescing before queueing the event.
+ *
+ * @param app Application that owns the event queue
+ * @param event Event to deliver
+ * @return true if the event was queued or merged, false if it was dropped
+ */
+bool podi_application_push_event(podi_application_common *app, const podi_event *event);
+
+/**
+ * @brief Check whether a wait has something to report
+ *
+ * True when the application queue or a per-window queue holds events, or
+ * anything was delivered since delivered_before was read, which covers
+ * events that went straight to the callback.
+ *
+ * @param app Application being waited on
+ * @param delivered_before delivered_count read when the wait started
+ * @return true if the wait should return
+ */
+bool podi_application_has_events(podi_application_common *app, uint64_t delivered_before);
+
+/**
+ * @brief Check whether a window wants events of a given type
+ *
+ * Lets backends skip translation work for event types masked out with
+ * podi_window_set_event_mask(). podi_application_push_event() applies the
+ * same filter, so calling this is an optimization, not a requirement.
+ *
+ * @param window Target window (NULL accepts everything)
+ * @param type Event type about to be generated
+ * @return true if the event should be generated
+ */
+bool podi_window_accepts_event(podi_window *window, podi_event_type type);
+
+/**
+ * @brief Apply an event to its window's input state snapshot
+ *
+ * Called by podi_application_push_event(); backends that bypass it must
+ * call this for every key, mouse and focus event they deliver.
+ *
+ * @param window Target window (NULL is ignored)
+ * @param event Event being delivered
+ */
+void podi_window_update_input_state(podi_window_common *window, const podi_event *event);
+
+/**
+ * @brief Build a PODI_EVENT_TEXT_INPUT event from backend key text
+ *
+ * Copies the text into the event, truncating at a character boundary if
+ * it does not fit. Control characters (backspace, return, escape, ...)
+ * are reported only as key events, so they produce no text event.
+ *
+ * @param event Event to fill
+ * @param window Window the text was typed into
+ * @param text UTF-8 text from the keymap or input method
+ * @param length Length of text in bytes
+ * @return true if event holds printable text and should be delivered
+ */
+bool podi_event_init_text_input(podi_event *event, podi_window *window, const char *text, size_t length);
+
 /* =============================================================================
  * Window Resize Helper Functions
  * ============================================================================= */
@@ -562,3 +1160,95 @@ podi_cursor_shape podi_resize_edge_to_cursor(podi_resize_edge edge);
  * @return true if event was handled, false otherwise
  */
 bool podi_handle_resize_event(podi_window *window, podi_event *event);
+
+/* =============================================================================
+ * Diagnostic Logging (log.c)
+ * ============================================================================= */
+
+/**
+ * @brief Most verbose log level compiled into the library
+ *
+ * 0 = error, 1 = warning, 2 = info, 3 = debug (matches podi_log_level).
+ * Calls above this level become dead code that the compiler removes, so
+ * per-event debug messages cost nothing outside debug builds (make debug
+ * defines PODI_LOG_MAX_LEVEL=3).
+ */
+#ifndef PODI_LOG_MAX_LEVEL
+#define PODI_LOG_MAX_LEVEL 2
+#endif
+
+/**
+ * @brief Format a message and hand it to the log sink
+ *
+ * Use the PODI_LOG_* macros instead, which honor PODI_LOG_MAX_LEVEL.
+ * Messages above the runtime level are discarded before formatting.
+ *
+ * @param level Severity of the message
+ * @param format printf-style format, without a trailing newline
+ */
+void podi_log(podi_log_level level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Disabled levels keep their arguments type-checked and "used" but never evaluated
+#define PODI_LOG_DISCARD(...) do { if (0) podi_log(PODI_LOG_LEVEL_DEBUG, __VA_ARGS__); } while (0)
+
+#define PODI_LOG_ERROR(...) podi_log(PODI_LOG_LEVEL_ERROR, __VA_ARGS__)
+#if PODI_LOG_MAX_LEVEL >= 1
+#define PODI_LOG_WARNING(...) podi_log(PODI_LOG_LEVEL_WARNING, __VA_ARGS__)
+#else
+#define PODI_LOG_WARNING(...) PODI_LOG_DISCARD(__VA_ARGS__)
+#endif
+#if PODI_LOG_MAX_LEVEL >= 2
+#define PODI_LOG_INFO(...) podi_log(PODI_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define PODI_LOG_INFO(...) PODI_LOG_DISCARD(__VA_ARGS__)
+#endif
+#if PODI_LOG_MAX_LEVEL >= 3
+#define PODI_LOG_DEBUG(...) podi_log(PODI_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define PODI_LOG_DEBUG(...) PODI_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+/* =============================================================================
+ * Trace Export (trace.c)
+ * ============================================================================= */
+
+/**
+ * @brief Chrome trace-event instrumentation
+ *
+ * Only built with PODI_ENABLE_TRACING (make TRACE=1); otherwise every macro
+ * expands to nothing. When enabled, spans are appended as Chrome trace JSON
+ * to the file named by PODI_TRACE_FILE, which opens in chrome://tracing and
+ * Perfetto. Without the variable the calls return immediately.
+ *
+ * PODI_TRACE_BEGIN/PODI_TRACE_END bracket a span explicitly and must be
+ * paired on the same thread. PODI_TRACE_SCOPE opens a span that ends when
+ * the enclosing block is left, including through return.
+ */
+#ifdef PODI_ENABLE_TRACING
+/**
+ * @brief Open a trace span on the calling thread
+ *
+ * @param name Span name (string literal or otherwise long-lived)
+ * @return name, so the scope helper can close the same span
+ */
+const char *podi_trace_begin(const char *name);
+
+/**
+ * @brief Close the innermost open trace span on the calling thread
+ *
+ * @param name Span name passed to podi_trace_begin()
+ */
+void podi_trace_end(const char *name);
+
+/** @brief Cleanup handler behind PODI_TRACE_SCOPE */
+void podi_trace_scope_end(const char **name);
+
+#define PODI_TRACE_BEGIN(name) podi_trace_begin(name)
+#define PODI_TRACE_END(name) podi_trace_end(name)
+#define PODI_TRACE_SCOPE(name) \
+    const char *podi_trace_scope_ __attribute__((cleanup(podi_trace_scope_end), unused)) = podi_trace_begin(name)
+#else
+#define PODI_TRACE_BEGIN(name) ((void)0)
+#define PODI_TRACE_END(name) ((void)0)
+#define PODI_TRACE_SCOPE(name) ((void)0)
+#endif
@@ -12,8 +12,10 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <sys/timerfd.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <poll.h>
 #include <linux/input-event-codes.h>
 #include <locale.h>
 #include <xkbcommon/xkbcommon.h>
@@ -25,6 +27,7 @@ typedef struct {
     struct wl_registry *registry;
     struct wl_compositor *compositor;
     struct wl_seat *seat;
+    uint32_t seat_version;
     struct wl_keyboard *keyboard;
     struct wl_pointer *pointer;
     struct xdg_wm_base *xdg_wm_base;
@@ -54,13 +57,51 @@ typedef struct {
     struct wl_cursor_theme *cursor_theme;
     struct wl_surface *cursor_surface;
     struct wl_buffer *hidden_cursor_buffer;
+    struct wl_cursor *cursor_cache[PODI_CURSOR_SHAPE_COUNT];  // Theme lookups, owned by cursor_theme
+    podi_cursor_shape cursor_shape;  // Shape on the pointer since the last enter, while cursor_shape_set
+    bool cursor_shape_set;
 
     // Pointer constraint protocols
     struct zwp_pointer_constraints_v1 *pointer_constraints;
     struct zwp_relative_pointer_manager_v1 *relative_pointer_manager;
+
+    // True between podi_application_prepare_read and dispatch_events
+    bool read_prepared;
+    int epoll_fd;           // Display, wakeup and repeat fds, for external event loops
+
+    // Maps compositor input timestamps to the monotonic clock
+    podi_clock_sync server_clock;
+    podi_clock_sync relative_clock;  // Microsecond clock of relative pointer events
+
+    // Client-side key repeat; wl_keyboard only reports the rate and delay
+    int repeat_fd;          // timerfd, readable when a repeat is due
+    int32_t repeat_rate;    // Repeats per second, 0 disables repeat
+    int32_t repeat_delay;   // Milliseconds before the first repeat
+    bool repeat_active;
+    uint32_t repeat_key;    // Evdev keycode being repeated
+    uint64_t repeat_next_ns;
+    uint64_t repeat_interval_ns;
+
+    // Windows that currently hold pointer and keyboard focus (NULL if none)
+    struct podi_window_wayland *pointer_focus;
+    struct podi_window_wayland *keyboard_focus;
+
+    // Pointer state accumulated until the next wl_pointer.frame, indexed
+    // by WL_POINTER_AXIS_* for the scroll axes
+    struct {
+        bool has_motion;
+        uint32_t motion_time;
+        wl_fixed_t motion_x;
+        wl_fixed_t motion_y;
+        bool has_axis;
+        uint32_t axis_time;
+        double axis_value[2];
+        int32_t axis_value120[2];
+        bool has_value120[2];
+    } pointer_frame;
 } podi_application_wayland;
 
-typedef struct {
+typedef struct podi_window_wayland {
     podi_window_common common;
     podi_application_wayland *app;
     struct wl_surface *surface;
@@ -91,6 +132,42 @@ static bool wayland_window_is_fullscreen_exclusive(podi_window *window_generic);
 static struct wl_buffer* wayland_get_hidden_cursor_buffer(podi_application_wayland *app);
 static void wayland_set_hidden_cursor(podi_window_wayland *window);
 
+// Sends buffered requests to the compositor, counted for podi_application_get_stats()
+static int wayland_flush(podi_application_wayland *app) {
+    PODI_STAT_INC(&app->common, flushes);
+    app->common.flush_pending = false;
+    return wl_display_flush(app->display);
+}
+
+// Requests from setters go out right away, or with the next poll/wait
+// once the application opted into deferred flushing
+static void wayland_request_flush(podi_application_wayland *app) {
+    if (app->common.flush_deferred) {
+        app->common.flush_pending = true;
+    } else {
+        wayland_flush(app);
+    }
+}
+
+static void wayland_flush_pending(podi_application_wayland *app) {
+    if (app->common.flush_pending) wayland_flush(app);
+}
+
+// Runs the listeners for everything already read, timed for the stats
+static int wayland_dispatch_pending(podi_application_wayland *app) {
+    PODI_STAT_TIMER_START(dispatch_start);
+    int result = wl_display_dispatch_pending(app->display);
+    PODI_STAT_TIMER_STOP(&app->common, dispatch_ns, dispatch_start);
+    return result;
+}
+
+// Window surfaces carry their podi window as user data; other surfaces
+// (cursor surface, surfaces from other libraries) map to NULL
+static podi_window_wayland *wayland_window_from_surface(struct wl_surface *surface) {
+    if (!surface) return NULL;
+    return (podi_window_wayland *)wl_surface_get_user_data(surface);
+}
+
 static uint32_t wayland_mods_to_podi_modifiers(uint32_t mods_depressed) {
     uint32_t modifiers = 0;
     if (mods_depressed & 1) modifiers |= PODI_MOD_SHIFT;  // Shift
@@ -158,27 +235,22 @@ static podi_key wayland_keycode_to_podi_key(uint32_t key) {
     }
 }
 
-#define MAX_PENDING_EVENTS 32
-static podi_event pending_events[MAX_PENDING_EVENTS];
-static size_t pending_event_count = 0;
+static void add_pending_event(podi_application_wayland *app, const podi_event *event) {
+    podi_application_push_event(&app->common, event);
+}
 
-static void add_pending_event(const podi_event *event) {
-    if (pending_event_count < MAX_PENDING_EVENTS) {
-        pending_events[pending_event_count++] = *event;
-    }
+static void wayland_key_repeat_drain(podi_application_wayland *app);
+
+static bool get_pending_event(podi_application_wayland *app, podi_event *event) {
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    wayland_key_repeat_drain(app);
+    return podi_event_queue_pop(&app->common.events, event);
 }
 
-static bool get_pending_event(podi_event *event) {
-    if (pending_event_count > 0) {
-        *event = pending_events[0];
-        // Shift remaining events
-        for (size_t i = 1; i < pending_event_count; i++) {
-            pending_events[i-1] = pending_events[i];
-        }
-        pending_event_count--;
-        return true;
-    }
-    return false;
+static size_t get_pending_events(podi_application_wayland *app, podi_event *events, size_t capacity) {
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    wayland_key_repeat_drain(app);
+    return podi_event_queue_pop_many(&app->common.events, events, capacity);
 }
 
 static void keyboard_keymap(void *data,
@@ -191,7 +263,8 @@ static void keyboard_keymap(void *data,
         return;
     }
 
-    char *keymap_string = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    // Seat version 7 and later require a private mapping of the keymap fd
+    char *keymap_string = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
     if (keymap_string == MAP_FAILED) {
         close(fd);
         return;
@@ -218,41 +291,102 @@ static void keyboard_keymap(void *data,
     close(fd);
 }
 
+static void wayland_key_repeat_stop(podi_application_wayland *app) {
+    if (!app->repeat_active) return;
+
+    app->repeat_active = false;
+    struct itimerspec disarm = {0};
+    timerfd_settime(app->repeat_fd, 0, &disarm, NULL);
+}
+
+static void wayland_key_repeat_start(podi_application_wayland *app, uint32_t key) {
+    if (app->repeat_fd < 0 || app->repeat_rate <= 0 || !app->xkb_keymap) return;
+    // Modifiers and similar keys are marked non-repeating in the keymap
+    if (!xkb_keymap_key_repeats(app->xkb_keymap, key + 8)) return;
+
+    uint64_t delay_ns = (uint64_t)(app->repeat_delay > 0 ? app->repeat_delay : 0) * 1000000ULL;
+    app->repeat_interval_ns = 1000000000ULL / (uint64_t)app->repeat_rate;
+    app->repeat_next_ns = podi_time_now_ns() + delay_ns;
+    app->repeat_key = key;
+    app->repeat_active = true;
+
+    // A zero it_value would disarm the timer, so round a zero delay up
+    struct itimerspec timer = {
+        .it_value = { .tv_sec = (time_t)(delay_ns / 1000000000ULL), .tv_nsec = (long)(delay_ns % 1000000000ULL) },
+        .it_interval = { .tv_sec = (time_t)(app->repeat_interval_ns / 1000000000ULL),
+                         .tv_nsec = (long)(app->repeat_interval_ns % 1000000000ULL) },
+    };
+    if (delay_ns == 0) timer.it_value.tv_nsec = 1;
+    timerfd_settime(app->repeat_fd, 0, &timer, NULL);
+}
+
+// Queues one KEY_DOWN per timer expiration since the last drain, stamped
+// with the time each repeat was due rather than when it was noticed
+static void wayland_key_repeat_drain(podi_application_wayland *app) {
+    if (!app->repeat_active) return;
+
+    uint64_t expirations = 0;
+    if (read(app->repeat_fd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations)) return;
+
+    char text[64];
+    int text_len = 0;
+    if (app->xkb_state) {
+        text_len = xkb_state_key_get_utf8(app->xkb_state, app->repeat_key + 8, text, sizeof(text));
+    }
+
+    for (uint64_t i = 0; i < expirations; i++) {
+        podi_event event = {0};
+        event.type = PODI_EVENT_KEY_DOWN;
+        event.window = (podi_window *)app->keyboard_focus;
+        event.timestamp_ns = app->repeat_next_ns;
+        event.key.key = wayland_keycode_to_podi_key(app->repeat_key);
+        event.key.native_keycode = app->repeat_key;
+        event.key.modifiers = app->modifier_state;
+        event.key.is_repeat = true;
+        add_pending_event(app, &event);
+
+        podi_event text_event;
+        if (text_len > 0 && podi_event_init_text_input(&text_event, event.window, text, (size_t)text_len)) {
+            text_event.timestamp_ns = event.timestamp_ns;
+            add_pending_event(app, &text_event);
+        }
+        app->repeat_next_ns += app->repeat_interval_ns;
+    }
+}
+
 static void keyboard_enter(void *data, struct wl_keyboard *keyboard __attribute__((unused)),
                          uint32_t serial __attribute__((unused)), struct wl_surface *surface,
                          struct wl_array *keys __attribute__((unused))) {
     podi_application_wayland *app = (podi_application_wayland *)data;
 
-    for (size_t i = 0; i < app->common.window_count; i++) {
-        podi_window_wayland *window = (podi_window_wayland *)app->common.windows[i];
-        if (window && window->surface == surface) {
-            podi_event event = {0};
-            event.type = PODI_EVENT_WINDOW_FOCUS;
-            event.window = (podi_window *)window;
-            add_pending_event(&event);
-            break;
-        }
+    podi_window_wayland *window = wayland_window_from_surface(surface);
+    app->keyboard_focus = window;
+    if (window) {
+        podi_event event = {0};
+        event.type = PODI_EVENT_WINDOW_FOCUS;
+        event.window = (podi_window *)window;
+        add_pending_event(app, &event);
     }
 }
 
 static void keyboard_leave(void *data, struct wl_keyboard *keyboard __attribute__((unused)),
                          uint32_t serial __attribute__((unused)), struct wl_surface *surface) {
     podi_application_wayland *app = (podi_application_wayland *)data;
-    
-    for (size_t i = 0; i < app->common.window_count; i++) {
-        podi_window_wayland *window = (podi_window_wayland *)app->common.windows[i];
-        if (window && window->surface == surface) {
-            podi_event event = {0};
-            event.type = PODI_EVENT_WINDOW_UNFOCUS;
-            event.window = (podi_window *)window;
-            add_pending_event(&event);
-            break;
-        }
+
+    // The surface may already be destroyed, so go by the tracked focus
+    podi_window_wayland *window = app->keyboard_focus;
+    app->keyboard_focus = NULL;
+    wayland_key_repeat_stop(app);
+    if (window && (!surface || window->surface == surface)) {
+        podi_event event = {0};
+        event.type = PODI_EVENT_WINDOW_UNFOCUS;
+        event.window = (podi_window *)window;
+        add_pending_event(app, &event);
     }
 }
 
 static void keyboard_key(void *data, struct wl_keyboard *keyboard __attribute__((unused)),
-                       uint32_t serial, uint32_t time __attribute__((unused)), uint32_t key,
+                       uint32_t serial, uint32_t time, uint32_t key,
                        uint32_t state) {
     podi_application_wayland *app = (podi_application_wayland *)data;
     app->last_input_serial = serial;
@@ -261,15 +395,15 @@ static void keyboard_key(void *data, struct wl_keyboard *keyboard __attribute__(
 
     podi_event event = {0};
     event.type = event_type;
-    event.window = app->common.window_count > 0 ? app->common.windows[0] : NULL;
+    event.window = (podi_window *)app->keyboard_focus;
+    event.timestamp_ns = podi_clock_sync_convert(&app->server_clock, time);
     event.key.key = wayland_keycode_to_podi_key(key);
     event.key.native_keycode = key;
     event.key.modifiers = app->modifier_state;
     
     // XKB-based text input with compose support
-    static char text_buffer[64];
-    text_buffer[0] = '\0';
-    event.key.text = NULL;
+    char text[64];
+    int text_len = 0;
 
     if (event_type == PODI_EVENT_KEY_DOWN && app->xkb_state) {
         // Update XKB state with this key press
@@ -288,11 +422,7 @@ static void keyboard_key(void *data, struct wl_keyboard *keyboard __attribute__(
                     break;
                 case XKB_COMPOSE_COMPOSED: {
                     // Sequence complete, get composed text
-                    int len = xkb_compose_state_get_utf8(app->compose_state, text_buffer, sizeof(text_buffer));
-                    if (len > 0) {
-                        text_buffer[len] = '\0';
-                        event.key.text = text_buffer;
-                    }
+                    text_len = xkb_compose_state_get_utf8(app->compose_state, text, sizeof(text));
                     xkb_compose_state_reset(app->compose_state);
                     break;
                 }
@@ -303,20 +433,12 @@ static void keyboard_key(void *data, struct wl_keyboard *keyboard __attribute__(
                 case XKB_COMPOSE_NOTHING:
                 default:
                     // No compose sequence, get text from keymap directly
-                    int len = xkb_state_key_get_utf8(app->xkb_state, keycode, text_buffer, sizeof(text_buffer));
-                    if (len > 0) {
-                        text_buffer[len] = '\0';
-                        event.key.text = text_buffer;
-                    }
+                    text_len = xkb_state_key_get_utf8(app->xkb_state, keycode, text, sizeof(text));
                     break;
             }
         } else {
             // No compose support, use direct keymap text
-            int len = xkb_state_key_get_utf8(app->xkb_state, keycode, text_buffer, sizeof(text_buffer));
-            if (len > 0) {
-                text_buffer[len] = '\0';
-                event.key.text = text_buffer;
-            }
+            text_len = xkb_state_key_get_utf8(app->xkb_state, keycode, text, sizeof(text));
         }
     } else if (event_type == PODI_EVENT_KEY_UP && app->xkb_state) {
         // Update XKB state for key release
@@ -324,7 +446,22 @@ static void keyboard_key(void *data, struct wl_keyboard *keyboard __attribute__(
         xkb_state_update_key(app->xkb_state, keycode, XKB_KEY_UP);
     }
     
-    add_pending_event(&event);
+    add_pending_event(app, &event);
+
+    // Text travels in its own event after the key that produced it
+    podi_event text_event;
+    if (text_len > 0 && podi_event_init_text_input(&text_event, event.window, text, (size_t)text_len)) {
+        text_event.timestamp_ns = event.timestamp_ns;
+        add_pending_event(app, &text_event);
+    }
+
+    // The newest press takes over repeating; releasing any other key keeps it going
+    if (event_type == PODI_EVENT_KEY_DOWN) {
+        wayland_key_repeat_stop(app);
+        wayland_key_repeat_start(app, key);
+    } else if (app->repeat_active && app->repeat_key == key) {
+        wayland_key_repeat_stop(app);
+    }
 }
 
 static void keyboard_modifiers(void *data, struct wl_keyboard *keyboard __attribute__((unused)),
@@ -339,8 +476,16 @@ static void keyboard_modifiers(void *data, struct wl_keyboard *keyboard __attrib
     }
 }
 
-static void keyboard_repeat_info(void *data __attribute__((unused)), struct wl_keyboard *keyboard __attribute__((unused)),
-                               int32_t rate __attribute__((unused)), int32_t delay __attribute__((unused))) {
+static void keyboard_repeat_info(void *data, struct wl_keyboard *keyboard __attribute__((unused)),
+                               int32_t rate, int32_t delay) {
+    podi_application_wayland *app = (podi_application_wayland *)data;
+    app->repeat_rate = rate;
+    app->repeat_delay = delay;
+
+    // New settings apply from the next press
+    if (rate <= 0) {
+        wayland_key_repeat_stop(app);
+    }
 }
 
 static const struct wl_keyboard_listener keyboard_listener = {
@@ -354,22 +499,40 @@ static const struct wl_keyboard_listener keyboard_listener = {
 
 // Relative pointer motion listener
 static void relative_pointer_motion(void *data, struct zwp_relative_pointer_v1 *zwp_relative_pointer __attribute__((unused)),
-                                   uint32_t utime_hi __attribute__((unused)), uint32_t utime_lo __attribute__((unused)),
+                                   uint32_t utime_hi, uint32_t utime_lo,
                                    wl_fixed_t dx, wl_fixed_t dy,
-                                   wl_fixed_t dx_unaccel __attribute__((unused)), wl_fixed_t dy_unaccel __attribute__((unused))) {
+                                   wl_fixed_t dx_unaccel, wl_fixed_t dy_unaccel) {
     podi_window_wayland *window = (podi_window_wayland *)data;
+    uint64_t utime = ((uint64_t)utime_hi << 32) | utime_lo;
+
+    // Every locked window has its own relative pointer on the shared
+    // wl_pointer; only the one under the pointer should report motion
+    if (window && window->app->pointer_focus != window) return;
+    if (window && !podi_window_accepts_event((podi_window *)window,
+                                             window->common.raw_motion ? PODI_EVENT_MOUSE_RAW_MOTION : PODI_EVENT_MOUSE_MOVE)) {
+        return;
+    }
 
-    if (window && window->common.cursor_locked) {
+    if (window && window->common.cursor_locked && window->common.raw_motion) {
+        podi_event event = {0};
+        event.type = PODI_EVENT_MOUSE_RAW_MOTION;
+        event.window = (podi_window*)window;
+        event.timestamp_ns = podi_clock_sync_convert_us(&window->app->relative_clock, utime);
+        event.raw_motion.delta_x = wl_fixed_to_double(dx_unaccel);
+        event.raw_motion.delta_y = wl_fixed_to_double(dy_unaccel);
+        event.raw_motion.device_time_us = utime;
+        add_pending_event(window->app, &event);
+    } else if (window && window->common.cursor_locked) {
         double delta_x = wl_fixed_to_double(dx);
         double delta_y = wl_fixed_to_double(dy);
 
-        printf("DEBUG: Relative pointer motion: dx=%.2f, dy=%.2f\n", delta_x, delta_y);
-        fflush(stdout);
+        PODI_LOG_DEBUG("Relative pointer motion: dx=%.2f, dy=%.2f", delta_x, delta_y);
 
         // Send a mouse move event with relative motion as deltas
         podi_event event = {0};
         event.type = PODI_EVENT_MOUSE_MOVE;
         event.window = (podi_window*)window;
+        event.timestamp_ns = podi_clock_sync_convert_us(&window->app->relative_clock, utime);
 
         // For locked cursor, we don't update absolute position
         event.mouse_move.x = window->common.cursor_center_x;
@@ -379,10 +542,9 @@ static void relative_pointer_motion(void *data, struct zwp_relative_pointer_v1 *
         event.mouse_move.delta_x = delta_x;
         event.mouse_move.delta_y = delta_y;
 
-        add_pending_event(&event);
+        add_pending_event(window->app, &event);
 
-        printf("DEBUG: Relative motion processed - persistent lock maintained\n");
-        fflush(stdout);
+        PODI_LOG_DEBUG("Relative motion processed - persistent lock maintained");
     }
 }
 
@@ -393,8 +555,7 @@ static const struct zwp_relative_pointer_v1_listener relative_pointer_listener =
 // Locked pointer event handlers
 static void locked_pointer_locked(void *data, struct zwp_locked_pointer_v1 *zwp_locked_pointer __attribute__((unused))) {
     podi_window_wayland *window = (podi_window_wayland *)data;
-    printf("DEBUG: Pointer locked successfully\n");
-    fflush(stdout);
+    PODI_LOG_DEBUG("Pointer locked successfully");
 
     // Mark lock as active
     window->is_locked_active = true;
@@ -402,16 +563,15 @@ static void locked_pointer_locked(void *data, struct zwp_locked_pointer_v1 *zwp_
     if (window && window->app && window->app->pointer && window->app->last_input_serial) {
         // Now try to hide the cursor since we have a valid lock
         wl_pointer_set_cursor(window->app->pointer, window->app->last_input_serial, NULL, 0, 0);
-        wl_display_flush(window->app->display);
-        printf("DEBUG: Cursor hidden after lock\n");
-        fflush(stdout);
+        window->app->cursor_shape_set = false;
+        wayland_request_flush(window->app);
+        PODI_LOG_DEBUG("Cursor hidden after lock");
     }
 }
 
 static void locked_pointer_unlocked(void *data, struct zwp_locked_pointer_v1 *zwp_locked_pointer __attribute__((unused))) {
     podi_window_wayland *window = (podi_window_wayland *)data;
-    printf("DEBUG: Pointer unlocked\n");
-    fflush(stdout);
+    PODI_LOG_DEBUG("Pointer unlocked");
 
     // Mark lock as inactive
     window->is_locked_active = false;
@@ -442,7 +602,6 @@ static void wayland_update_cursor_visibility(podi_window_wayland *window) {
         wayland_set_hidden_cursor(window);
     } else {
         wayland_window_set_cursor((podi_window*)window, PODI_CURSOR_DEFAULT);
-        wl_display_flush(app->display);
     }
 }
 
@@ -498,21 +657,26 @@ static struct wl_buffer* wayland_get_hidden_cursor_buffer(podi_application_wayla
 static void wayland_set_hidden_cursor(podi_window_wayland *window) {
     if (!window || !window->app || !window->app->pointer) return;
 
+    window->app->cursor_shape_set = false;
+
     struct wl_buffer *buffer = wayland_get_hidden_cursor_buffer(window->app);
     if (!buffer) {
         wl_pointer_set_cursor(window->app->pointer, window->app->last_input_serial, NULL, 0, 0);
-        wl_display_flush(window->app->display);
+        wayland_request_flush(window->app);
         return;
     }
 
+    PODI_STAT_INC(&window->app->common, cursor_uploads);
     wl_surface_attach(window->app->cursor_surface, buffer, 0, 0);
     wl_surface_damage(window->app->cursor_surface, 0, 0, 1, 1);
     wl_surface_commit(window->app->cursor_surface);
     wl_pointer_set_cursor(window->app->pointer, window->app->last_input_serial,
                           window->app->cursor_surface, 0, 0);
-    wl_display_flush(window->app->display);
+    wayland_request_flush(window->app);
 }
 
+static void wayland_pointer_flush_frame(podi_application_wayland *app);
+
 static void pointer_enter(void *data, struct wl_pointer *pointer __attribute__((unused)),
                         uint32_t serial, struct wl_surface *surface,
                         wl_fixed_t sx, wl_fixed_t sy) {
@@ -520,58 +684,60 @@ static void pointer_enter(void *data, struct wl_pointer *pointer __attribute__((
 
     // Store the input serial for cursor operations
     app->last_input_serial = serial;
+    wayland_pointer_flush_frame(app);
 
-    for (size_t i = 0; i < app->common.window_count; i++) {
-        podi_window_wayland *window = (podi_window_wayland *)app->common.windows[i];
-        if (window && window->surface == surface) {
-            // Initialize cursor position to avoid wrong deltas on first motion
-            double enter_x = wl_fixed_to_double(sx);
-            double enter_y = wl_fixed_to_double(sy);
-            window->common.last_cursor_x = enter_x;
-            window->common.last_cursor_y = enter_y;
+    // The compositor expects a fresh set_cursor for every enter
+    app->cursor_shape_set = false;
 
-            printf("DEBUG: Cursor entered window at (%.2f, %.2f)\n", enter_x, enter_y);
-            fflush(stdout);
+    podi_window_wayland *window = wayland_window_from_surface(surface);
+    app->pointer_focus = window;
+    if (!window) return;
 
-            // Apply desired cursor visibility now that we have a valid serial
-            window->pending_cursor_update = false;
-            wayland_update_cursor_visibility(window);
+    // Initialize cursor position to avoid wrong deltas on first motion
+    double enter_x = wl_fixed_to_double(sx);
+    double enter_y = wl_fixed_to_double(sy);
+    window->common.last_cursor_x = enter_x;
+    window->common.last_cursor_y = enter_y;
+    window->last_mouse_x = enter_x;
+    window->last_mouse_y = enter_y;
 
-            podi_event event = {0};
-            event.type = PODI_EVENT_MOUSE_ENTER;
-            event.window = (podi_window *)window;
-            add_pending_event(&event);
-            break;
-        }
-    }
+    PODI_LOG_DEBUG("Cursor entered window at (%.2f, %.2f)", enter_x, enter_y);
+
+    // Apply desired cursor visibility now that we have a valid serial
+    window->pending_cursor_update = false;
+    wayland_update_cursor_visibility(window);
+
+    podi_event event = {0};
+    event.type = PODI_EVENT_MOUSE_ENTER;
+    event.window = (podi_window *)window;
+    add_pending_event(app, &event);
 }
 
 static void pointer_leave(void *data, struct wl_pointer *pointer __attribute__((unused)),
                         uint32_t serial __attribute__((unused)), struct wl_surface *surface) {
     podi_application_wayland *app = (podi_application_wayland *)data;
 
-    for (size_t i = 0; i < app->common.window_count; i++) {
-        podi_window_wayland *window = (podi_window_wayland *)app->common.windows[i];
-        if (window && window->surface == surface) {
-            podi_event event = {0};
-            event.type = PODI_EVENT_MOUSE_LEAVE;
-            event.window = (podi_window *)window;
-            add_pending_event(&event);
-            break;
-        }
+    wayland_pointer_flush_frame(app);
+
+    // The surface may already be destroyed, so go by the tracked focus
+    podi_window_wayland *window = app->pointer_focus;
+    app->pointer_focus = NULL;
+    if (window && (!surface || window->surface == surface)) {
+        podi_event event = {0};
+        event.type = PODI_EVENT_MOUSE_LEAVE;
+        event.window = (podi_window *)window;
+        add_pending_event(app, &event);
     }
 }
 
-static void pointer_motion(void *data, struct wl_pointer *pointer __attribute__((unused)),
-                         uint32_t time __attribute__((unused)), wl_fixed_t sx, wl_fixed_t sy) {
-    podi_application_wayland *app = (podi_application_wayland *)data;
-
+static void wayland_pointer_emit_motion(podi_application_wayland *app,
+                                        uint32_t time, wl_fixed_t sx, wl_fixed_t sy) {
     double new_x = wl_fixed_to_double(sx);
     double new_y = wl_fixed_to_double(sy);
 
     // Track mouse position in the current window for title bar detection
-    if (app->common.window_count > 0) {
-        podi_window_wayland *window = (podi_window_wayland *)app->common.windows[0];
+    podi_window_wayland *window = app->pointer_focus;
+    if (window) {
 
         // Update window's mouse tracking (used for title bar detection)
         window->last_mouse_x = new_x;
@@ -579,19 +745,28 @@ static void pointer_motion(void *data, struct wl_pointer *pointer __attribute__(
 
         // Don't send mouse events when cursor is locked - check both state and active flag
         if (window->common.cursor_locked || window->is_locked_active) {
-            printf("DEBUG: Skipping normal pointer motion - cursor is locked (state=%s, active=%s)\n",
-                   window->common.cursor_locked ? "true" : "false",
-                   window->is_locked_active ? "true" : "false");
-            fflush(stdout);
+            PODI_LOG_DEBUG("Skipping normal pointer motion - cursor is locked (state=%s, active=%s)",
+                           window->common.cursor_locked ? "true" : "false",
+                           window->is_locked_active ? "true" : "false");
             return; // Relative pointer events will be handled by relative_pointer_motion
         }
 
         double scale = window->common.scale_factor > 0.0 ? window->common.scale_factor : 1.0;
 
+        if (!podi_window_accepts_event((podi_window *)window, PODI_EVENT_MOUSE_MOVE)) {
+            // Keep the state edge-resize clicks rely on, skip building the event
+            window->common.last_mouse_x = new_x * scale;
+            window->common.last_mouse_y = new_y * scale;
+            window->common.last_cursor_x = new_x;
+            window->common.last_cursor_y = new_y;
+            return;
+        }
+
         // Send normal mouse move event for unlocked cursor
         podi_event event = {0};
         event.type = PODI_EVENT_MOUSE_MOVE;
         event.window = (podi_window*)window;
+        event.timestamp_ns = podi_clock_sync_convert(&app->server_clock, time);
         event.mouse_move.x = new_x * scale;
         event.mouse_move.y = new_y * scale;
 
@@ -603,9 +778,8 @@ static void pointer_motion(void *data, struct wl_pointer *pointer __attribute__(
         event.mouse_move.delta_x = delta_physical_x;
         event.mouse_move.delta_y = delta_physical_y;
 
-        printf("DEBUG: Wayland motion: pos=(%.2f, %.2f) delta=(%.2f, %.2f)\n",
-               new_x * scale, new_y * scale, delta_physical_x, delta_physical_y);
-        fflush(stdout);
+        PODI_LOG_DEBUG("Wayland motion: pos=(%.2f, %.2f) delta=(%.2f, %.2f)",
+                       new_x * scale, new_y * scale, delta_physical_x, delta_physical_y);
 
         window->common.last_cursor_x = new_x;
         window->common.last_cursor_y = new_y;
@@ -616,39 +790,99 @@ static void pointer_motion(void *data, struct wl_pointer *pointer __attribute__(
         }
 
         if (!consumed) {
-            add_pending_event(&event);
+            add_pending_event(app, &event);
+        }
+    }
+}
+
+// Scroll amounts are reported in wheel notches like X11 (positive y is up,
+// positive x is left); axis events without a discrete step count use the
+// compositor's continuous value, which is roughly this many units per notch
+#define PODI_WAYLAND_SCROLL_UNITS_PER_NOTCH 10.0
+
+static double wayland_pointer_frame_scroll(podi_application_wayland *app, uint32_t axis) {
+    if (app->pointer_frame.has_value120[axis]) {
+        return -(double)app->pointer_frame.axis_value120[axis] / 120.0;
+    }
+    return -app->pointer_frame.axis_value[axis] / PODI_WAYLAND_SCROLL_UNITS_PER_NOTCH;
+}
+
+// Emits the motion and scroll gathered since the last wl_pointer.frame as
+// one event each, so a frame never produces more than one move or scroll
+static void wayland_pointer_flush_frame(podi_application_wayland *app) {
+    if (app->pointer_frame.has_motion) {
+        wayland_pointer_emit_motion(app, app->pointer_frame.motion_time,
+                                    app->pointer_frame.motion_x, app->pointer_frame.motion_y);
+    }
+
+    if (app->pointer_frame.has_axis && app->pointer_focus) {
+        double scroll_x = wayland_pointer_frame_scroll(app, WL_POINTER_AXIS_HORIZONTAL_SCROLL);
+        double scroll_y = wayland_pointer_frame_scroll(app, WL_POINTER_AXIS_VERTICAL_SCROLL);
+
+        // Frames that only carry axis_stop or a zero delta have nothing to report
+        if (scroll_x != 0.0 || scroll_y != 0.0) {
+            podi_event event = {0};
+            event.type = PODI_EVENT_MOUSE_SCROLL;
+            event.window = (podi_window *)app->pointer_focus;
+            event.timestamp_ns = podi_clock_sync_convert(&app->server_clock, app->pointer_frame.axis_time);
+            event.mouse_scroll.x = scroll_x;
+            event.mouse_scroll.y = scroll_y;
+            add_pending_event(app, &event);
         }
     }
+
+    memset(&app->pointer_frame, 0, sizeof(app->pointer_frame));
+}
+
+// Seats older than version 5 never send wl_pointer.frame, so every event
+// is its own frame there
+static bool wayland_pointer_has_frames(podi_application_wayland *app) {
+    return app->seat_version >= 5;
+}
+
+static void pointer_motion(void *data, struct wl_pointer *pointer __attribute__((unused)),
+                         uint32_t time, wl_fixed_t sx, wl_fixed_t sy) {
+    podi_application_wayland *app = (podi_application_wayland *)data;
+
+    // Only the last position of a frame matters; deltas are taken against
+    // the previously emitted position so nothing is lost by dropping the rest
+    app->pointer_frame.has_motion = true;
+    app->pointer_frame.motion_time = time;
+    app->pointer_frame.motion_x = sx;
+    app->pointer_frame.motion_y = sy;
+
+    if (!wayland_pointer_has_frames(app)) {
+        wayland_pointer_flush_frame(app);
+    }
 }
 
 static void pointer_button(void *data, struct wl_pointer *pointer __attribute__((unused)),
-                         uint32_t serial, uint32_t time __attribute__((unused)), uint32_t button,
+                         uint32_t serial, uint32_t time, uint32_t button,
                          uint32_t state) {
     podi_application_wayland *app = (podi_application_wayland *)data;
     app->last_input_serial = serial;
 
-    if (app->common.window_count > 0) {
-        podi_window_wayland *window = (podi_window_wayland *)app->common.windows[0];
-        if (window && window->pending_cursor_update) {
-            wayland_update_cursor_visibility(window);
-        }
+    // Buttons are delivered as they arrive, after any motion of the same
+    // frame, so clicks land at the position the compositor reported
+    wayland_pointer_flush_frame(app);
+
+    podi_window_wayland *window = app->pointer_focus;
+    if (window && window->pending_cursor_update) {
+        wayland_update_cursor_visibility(window);
     }
 
     // Check for Alt+Left-click to initiate window move
     if (button == BTN_LEFT && state == WL_POINTER_BUTTON_STATE_PRESSED &&
         (app->modifier_state & PODI_MOD_ALT) &&
-        app->common.window_count > 0) {
-        podi_window *window = app->common.windows[0];
-        wayland_window_begin_move(window);
+        window) {
+        wayland_window_begin_move((podi_window *)window);
         return; // Don't send normal mouse event
     }
 
     // Check for title bar click (only if no server decorations and not in resize edge)
     if (button == BTN_LEFT && state == WL_POINTER_BUTTON_STATE_PRESSED &&
         !(app->modifier_state & PODI_MOD_ALT) &&
-        app->common.window_count > 0) {
-        podi_window_wayland *window = (podi_window_wayland *)app->common.windows[0];
-
+        window) {
 
         // Only activate title bar for windows without server decorations
         if (!window->has_server_decorations &&
@@ -666,7 +900,8 @@ static void pointer_button(void *data, struct wl_pointer *pointer __attribute__(
 
     podi_event event = {0};
     event.type = event_type;
-    event.window = app->common.window_count > 0 ? app->common.windows[0] : NULL;
+    event.window = (podi_window *)window;
+    event.timestamp_ns = podi_clock_sync_convert(&app->server_clock, time);
     switch (button) {
         case BTN_LEFT:
             event.mouse_button.button = PODI_MOUSE_BUTTON_LEFT;
@@ -686,26 +921,27 @@ static void pointer_button(void *data, struct wl_pointer *pointer __attribute__(
     }
 
     if (!consumed) {
-        add_pending_event(&event);
+        add_pending_event(app, &event);
     }
 }
 
-static void pointer_axis(void *data __attribute__((unused)), struct wl_pointer *pointer __attribute__((unused)),
-                       uint32_t time __attribute__((unused)), uint32_t axis, wl_fixed_t value) {
-    podi_event event = {0};
-    event.type = PODI_EVENT_MOUSE_SCROLL;
-    
-    if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL) {
-        event.mouse_scroll.x = 0.0;
-        event.mouse_scroll.y = -wl_fixed_to_double(value) / 10.0;
-    } else if (axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL) {
-        event.mouse_scroll.x = wl_fixed_to_double(value) / 10.0;
-        event.mouse_scroll.y = 0.0;
+static void pointer_axis(void *data, struct wl_pointer *pointer __attribute__((unused)),
+                       uint32_t time, uint32_t axis, wl_fixed_t value) {
+    podi_application_wayland *app = (podi_application_wayland *)data;
+    if (axis > WL_POINTER_AXIS_HORIZONTAL_SCROLL) return;
+
+    app->pointer_frame.has_axis = true;
+    app->pointer_frame.axis_time = time;
+    app->pointer_frame.axis_value[axis] += wl_fixed_to_double(value);
+
+    if (!wayland_pointer_has_frames(app)) {
+        wayland_pointer_flush_frame(app);
     }
-    add_pending_event(&event);
 }
 
-static void pointer_frame(void *data __attribute__((unused)), struct wl_pointer *pointer __attribute__((unused))) {
+static void pointer_frame(void *data, struct wl_pointer *pointer __attribute__((unused))) {
+    podi_application_wayland *app = (podi_application_wayland *)data;
+    wayland_pointer_flush_frame(app);
 }
 
 static void pointer_axis_source(void *data __attribute__((unused)), struct wl_pointer *pointer __attribute__((unused)),
@@ -716,12 +952,24 @@ static void pointer_axis_stop(void *data __attribute__((unused)), struct wl_poin
                              uint32_t time __attribute__((unused)), uint32_t axis __attribute__((unused))) {
 }
 
-static void pointer_axis_discrete(void *data __attribute__((unused)), struct wl_pointer *pointer __attribute__((unused)),
-                                 uint32_t axis __attribute__((unused)), int32_t discrete __attribute__((unused))) {
+// Seat versions 5-7 count whole wheel notches; version 8 replaces this with
+// axis_value120, so only one of the two is ever sent
+static void pointer_axis_discrete(void *data, struct wl_pointer *pointer __attribute__((unused)),
+                                 uint32_t axis, int32_t discrete) {
+    podi_application_wayland *app = (podi_application_wayland *)data;
+    if (axis > WL_POINTER_AXIS_HORIZONTAL_SCROLL) return;
+
+    app->pointer_frame.axis_value120[axis] += discrete * 120;
+    app->pointer_frame.has_value120[axis] = true;
 }
 
-static void pointer_axis_value120(void *data __attribute__((unused)), struct wl_pointer *pointer __attribute__((unused)),
-                                 uint32_t axis __attribute__((unused)), int32_t value120 __attribute__((unused))) {
+static void pointer_axis_value120(void *data, struct wl_pointer *pointer __attribute__((unused)),
+                                 uint32_t axis, int32_t value120) {
+    podi_application_wayland *app = (podi_application_wayland *)data;
+    if (axis > WL_POINTER_AXIS_HORIZONTAL_SCROLL) return;
+
+    app->pointer_frame.axis_value120[axis] += value120;
+    app->pointer_frame.has_value120[axis] = true;
 }
 
 static void pointer_axis_relative_direction(void *data __attribute__((unused)), struct wl_pointer *pointer __attribute__((unused)),
@@ -853,9 +1101,8 @@ static void xdg_toplevel_configure(void *data, struct xdg_toplevel *xdg_toplevel
 
     window->common.fullscreen_exclusive = is_fullscreen;
 
-    printf("DEBUG: xdg_toplevel_configure called: width=%d, height=%d, scale=%.1f\n",
-           width, height, window->common.scale_factor);
-    fflush(stdout);
+    PODI_LOG_DEBUG("xdg_toplevel_configure called: width=%d, height=%d, scale=%.1f",
+                   width, height, window->common.scale_factor);
 
     // Convert logical size from Wayland to physical size for consistency with X11
     if (width > 0 && height > 0) {
@@ -892,7 +1139,7 @@ static void xdg_toplevel_configure(void *data, struct xdg_toplevel *xdg_toplevel
             event.window = (podi_window *)window;
             event.window_resize.width = physical_width;
             event.window_resize.height = physical_height;
-            add_pending_event(&event);
+            add_pending_event(window->app, &event);
         }
     }
 }
@@ -903,7 +1150,7 @@ static void xdg_toplevel_close(void *data, struct xdg_toplevel *xdg_toplevel __a
     podi_event event = {0};
     event.type = PODI_EVENT_WINDOW_CLOSE;
     event.window = (podi_window *)window;
-    add_pending_event(&event);
+    add_pending_event(window->app, &event);
 }
 
 static void xdg_toplevel_configure_bounds(void *data __attribute__((unused)), 
@@ -954,8 +1201,7 @@ static void decoration_configure(void *data,
             window->has_server_decorations = false;
             break;
     }
-    printf("Podi: Decoration mode set to %s (%u)\n", mode_str, mode);
-    fflush(stdout);
+    PODI_LOG_INFO("Decoration mode set to %s (%u)", mode_str, mode);
 }
 
 static const struct zxdg_toplevel_decoration_v1_listener decoration_listener = {
@@ -963,34 +1209,32 @@ static const struct zxdg_toplevel_decoration_v1_listener decoration_listener = {
 };
 
 static void registry_global(void *data, struct wl_registry *registry,
-                          uint32_t name, const char *interface, uint32_t version __attribute__((unused))) {
+                          uint32_t name, const char *interface, uint32_t version) {
     podi_application_wayland *app = (podi_application_wayland *)data;
 
-    printf("DEBUG: Found Wayland protocol: %s\n", interface);
-    fflush(stdout);
+    PODI_LOG_DEBUG("Found Wayland protocol: %s", interface);
 
     if (strcmp(interface, wl_compositor_interface.name) == 0) {
         app->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 4);
     } else if (strcmp(interface, wl_seat_interface.name) == 0) {
-        app->seat = wl_registry_bind(registry, name, &wl_seat_interface, 1);
+        // Version 8 brings wl_pointer.frame (5) and high-resolution scrolling
+        app->seat_version = version < 8 ? version : 8;
+        app->seat = wl_registry_bind(registry, name, &wl_seat_interface, app->seat_version);
         wl_seat_add_listener(app->seat, &seat_listener, app);
     } else if (strcmp(interface, xdg_wm_base_interface.name) == 0) {
         app->xdg_wm_base = wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
         xdg_wm_base_add_listener(app->xdg_wm_base, &xdg_wm_base_listener, app);
     } else if (strcmp(interface, zxdg_decoration_manager_v1_interface.name) == 0) {
         app->decoration_manager = wl_registry_bind(registry, name, &zxdg_decoration_manager_v1_interface, 1);
-        printf("Podi: Decoration manager found - server-side decorations available\n");
-        fflush(stdout);
+        PODI_LOG_INFO("Decoration manager found - server-side decorations available");
     } else if (strcmp(interface, wl_shm_interface.name) == 0) {
         app->shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
     } else if (strcmp(interface, zwp_pointer_constraints_v1_interface.name) == 0) {
         app->pointer_constraints = wl_registry_bind(registry, name, &zwp_pointer_constraints_v1_interface, 1);
-        printf("Podi: Pointer constraints found - cursor locking available\n");
-        fflush(stdout);
+        PODI_LOG_INFO("Pointer constraints found - cursor locking available");
     } else if (strcmp(interface, zwp_relative_pointer_manager_v1_interface.name) == 0) {
         app->relative_pointer_manager = wl_registry_bind(registry, name, &zwp_relative_pointer_manager_v1_interface, 1);
-        printf("Podi: Relative pointer manager found - relative movement available\n");
-        fflush(stdout);
+        PODI_LOG_INFO("Relative pointer manager found - relative movement available");
     } else if (strcmp(interface, wl_output_interface.name) == 0) {
         // Add output to our tracking list
         if (app->output_count >= app->output_capacity) {
@@ -1028,14 +1272,21 @@ static float wayland_get_display_scale_factor(podi_application *app_generic) {
     return (float)app->max_scale;
 }
 
+static void wayland_application_destroy(podi_application *app_generic);
+
 static podi_application *wayland_application_create(void) {
-    printf("Podi: Creating Wayland application\n");
-    fflush(stdout);
+    PODI_LOG_INFO("Creating Wayland application");
     podi_application_wayland *app = calloc(1, sizeof(podi_application_wayland));
     if (!app) return NULL;
 
     // Initialize output tracking
     app->max_scale = 1;
+
+    // Common desktop defaults until the compositor sends repeat_info
+    app->repeat_fd = -1;
+    app->epoll_fd = -1;
+    app->repeat_rate = 25;
+    app->repeat_delay = 600;
     
     app->display = wl_display_connect(NULL);
     if (!app->display) {
@@ -1048,6 +1299,7 @@ static podi_application *wayland_application_create(void) {
     
     wl_display_dispatch(app->display);
     wl_display_roundtrip(app->display);
+    PODI_STAT_ADD(&app->common, round_trips, 2);
 
     if (!app->compositor || !app->xdg_wm_base) {
         wl_display_disconnect(app->display);
@@ -1079,6 +1331,24 @@ static podi_application *wayland_application_create(void) {
         }
     }
 
+    if (!podi_wakeup_init(&app->common.wakeup)) {
+        wayland_application_destroy((podi_application *)app);
+        return NULL;
+    }
+
+    app->repeat_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (app->repeat_fd < 0) {
+        wayland_application_destroy((podi_application *)app);
+        return NULL;
+    }
+
+    int fds[3] = { wl_display_get_fd(app->display), app->common.wakeup.fd, app->repeat_fd };
+    app->epoll_fd = podi_epoll_create(fds, 3);
+    if (app->epoll_fd < 0) {
+        wayland_application_destroy((podi_application *)app);
+        return NULL;
+    }
+
     return (podi_application *)app;
 }
 
@@ -1092,6 +1362,10 @@ static void wayland_application_destroy(podi_application *app_generic) {
         }
     }
     free(app->common.windows);
+    podi_event_queue_free(&app->common.events);
+    podi_wakeup_destroy(&app->common.wakeup);
+    if (app->repeat_fd >= 0) close(app->repeat_fd);
+    if (app->epoll_fd >= 0) close(app->epoll_fd);
     
     // Cleanup cursor resources
     if (app->hidden_cursor_buffer) wl_buffer_destroy(app->hidden_cursor_buffer);
@@ -1135,29 +1409,190 @@ static void wayland_application_close(podi_application *app_generic) {
     if (app) app->common.should_close = true;
 }
 
+// Reads and dispatches whatever the compositor has sent, waiting up to
+// timeout_ns for the socket to become readable (0 = don't block)
+static bool wayland_read_events(podi_application_wayland *app, int64_t timeout_ns) {
+    struct wl_display *display = app->display;
+
+    // Drop a read left prepared by an external event loop
+    if (app->read_prepared) {
+        app->read_prepared = false;
+        wl_display_cancel_read(display);
+    }
+
+    while (wl_display_prepare_read(display) != 0) {
+        wayland_dispatch_pending(app);
+    }
+
+    // Don't sleep if dispatching already produced events to return
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    wayland_key_repeat_drain(app);
+    if (app->common.events.count > 0) {
+        timeout_ns = 0;
+    }
+
+    wayland_flush(app);
+
+    struct pollfd pfds[3] = {
+        { .fd = wl_display_get_fd(display), .events = POLLIN },
+        { .fd = app->common.wakeup.fd, .events = POLLIN },
+        { .fd = app->repeat_fd, .events = POLLIN },
+    };
+    int ready = podi_poll(pfds, 3, timeout_ns);
+    if (ready > 0 && (pfds[0].revents & POLLIN)) {
+        if (wl_display_read_events(display) < 0) return false;
+    } else {
+        wl_display_cancel_read(display);
+        if (ready < 0 || (pfds[0].revents & (POLLERR | POLLHUP))) return false;
+    }
+
+    if (pfds[1].revents & POLLIN) {
+        podi_wakeup_acknowledge(&app->common.wakeup);
+        podi_wakeup_drain(&app->common.wakeup, &app->common);
+    }
+
+    if (pfds[2].revents & POLLIN) {
+        wayland_key_repeat_drain(app);
+    }
+
+    return wayland_dispatch_pending(app) >= 0;
+}
+
 static bool wayland_application_poll_event(podi_application *app_generic, podi_event *event) {
     podi_application_wayland *app = (podi_application_wayland *)app_generic;
     if (!app || !event) return false;
 
-    while (true) {
-        // Process pending events first
-        wl_display_dispatch_pending(app->display);
+    wayland_flush_pending(app);
 
-        if (get_pending_event(event)) {
-            return true;
-        }
+    // Process pending events first
+    wayland_dispatch_pending(app);
 
-        // If no pending events, try to read from the socket without blocking
-        if (wl_display_prepare_read(app->display) == 0) {
-            wl_display_read_events(app->display);
-            wl_display_dispatch_pending(app->display);
+    if (get_pending_event(app, event)) {
+        return true;
+    }
 
-            if (get_pending_event(event)) {
-                return true;
-            }
-        }
+    // If no pending events, read from the socket only if data is ready
+    wayland_read_events(app, 0);
+    return get_pending_event(app, event);
+}
+
+static size_t wayland_application_poll_events(podi_application *app_generic, podi_event *events, size_t capacity) {
+    podi_application_wayland *app = (podi_application_wayland *)app_generic;
+    if (!app || !events || capacity == 0) return 0;
+
+    wayland_flush_pending(app);
+    wayland_dispatch_pending(app);
+
+    size_t count = get_pending_events(app, events, capacity);
+    if (count > 0) {
+        return count;
+    }
+
+    // Nothing queued yet - read from the socket once and copy out what it produced
+    wayland_read_events(app, 0);
+    return get_pending_events(app, events, capacity);
+}
+
+static int wayland_application_get_fd(podi_application *app_generic) {
+    podi_application_wayland *app = (podi_application_wayland *)app_generic;
+    if (!app) return -1;
+    return app->epoll_fd;
+}
 
-        return false; // No more events
+static bool wayland_application_prepare_read(podi_application *app_generic) {
+    podi_application_wayland *app = (podi_application_wayland *)app_generic;
+    if (!app) return false;
+    if (app->read_prepared) return true;
+
+    while (wl_display_prepare_read(app->display) != 0) {
+        wayland_dispatch_pending(app);
+    }
+
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    wayland_key_repeat_drain(app);
+    if (app->common.events.count > 0) {
+        wl_display_cancel_read(app->display);
+        return false;
+    }
+
+    wayland_flush(app);
+    app->read_prepared = true;
+    return true;
+}
+
+static bool wayland_application_dispatch_events(podi_application *app_generic, bool fd_readable) {
+    podi_application_wayland *app = (podi_application_wayland *)app_generic;
+    if (!app) return false;
+
+    wayland_flush_pending(app);
+
+    if (!app->read_prepared) {
+        // No prepare_read from the caller, so go through the normal read path
+        return fd_readable ? wayland_read_events(app, 0) : wayland_dispatch_pending(app) >= 0;
+    }
+
+    app->read_prepared = false;
+    if (!fd_readable) {
+        wl_display_cancel_read(app->display);
+        return wayland_dispatch_pending(app) >= 0;
+    }
+
+    // The epoll descriptor doesn't say which member woke it, so ask each
+    struct pollfd pfds[3] = {
+        { .fd = wl_display_get_fd(app->display), .events = POLLIN },
+        { .fd = app->common.wakeup.fd, .events = POLLIN },
+        { .fd = app->repeat_fd, .events = POLLIN },
+    };
+    int ready = podi_poll(pfds, 3, 0);
+    if (ready > 0 && (pfds[0].revents & POLLIN)) {
+        if (wl_display_read_events(app->display) < 0) return false;
+    } else {
+        wl_display_cancel_read(app->display);
+        if (ready < 0 || (pfds[0].revents & (POLLERR | POLLHUP))) return false;
+    }
+
+    if (pfds[1].revents & POLLIN) {
+        podi_wakeup_acknowledge(&app->common.wakeup);
+        podi_wakeup_drain(&app->common.wakeup, &app->common);
+    }
+
+    if (pfds[2].revents & POLLIN) {
+        wayland_key_repeat_drain(app);
+    }
+
+    return wayland_dispatch_pending(app) >= 0;
+}
+
+static void wayland_application_flush(podi_application *app_generic) {
+    podi_application_wayland *app = (podi_application_wayland *)app_generic;
+    if (app) wayland_flush(app);
+}
+
+static bool wayland_application_wait_events(podi_application *app_generic, int64_t timeout_ns) {
+    podi_application_wayland *app = (podi_application_wayland *)app_generic;
+    if (!app) return false;
+
+    wayland_flush_pending(app);
+
+    // Events can also go to window queues or the callback, which the
+    // application queue doesn't show, so watch the delivery counter too
+    uint64_t delivered = app->common.delivered_count;
+    if (podi_application_has_events(&app->common, delivered)) return true;
+
+    uint64_t start = podi_time_now_ns();
+    int64_t remaining = timeout_ns;
+
+    while (true) {
+        if (!wayland_read_events(app, remaining)) return false;
+        if (podi_application_has_events(&app->common, delivered)) return true;
+
+        // Woken by protocol traffic that produced no events (pings, cursor
+        // buffers, ...); keep sleeping for the rest of the timeout
+        if (timeout_ns >= 0) {
+            uint64_t elapsed = podi_time_now_ns() - start;
+            if (elapsed >= (uint64_t)timeout_ns) return false;
+            remaining = timeout_ns - (int64_t)elapsed;
+        }
     }
 }
 
@@ -1211,6 +1646,7 @@ static podi_window *wayland_window_create(podi_application *app_generic, const c
 
 
     window->surface = wl_compositor_create_surface(app->compositor);
+    wl_surface_set_user_data(window->surface, window);
     window->xdg_surface = xdg_wm_base_get_xdg_surface(app->xdg_wm_base, window->surface);
     window->xdg_toplevel = xdg_surface_get_toplevel(window->xdg_surface);
 
@@ -1221,8 +1657,7 @@ static podi_window *wayland_window_create(podi_application *app_generic, const c
 
     // Create decoration object if decoration manager is available
     if (app->decoration_manager) {
-        printf("Podi: Requesting server-side decorations for window\n");
-        fflush(stdout);
+        PODI_LOG_INFO("Requesting server-side decorations for window");
         window->decoration = zxdg_decoration_manager_v1_get_toplevel_decoration(
             app->decoration_manager, window->xdg_toplevel);
         zxdg_toplevel_decoration_v1_add_listener(window->decoration, &decoration_listener, window);
@@ -1230,8 +1665,7 @@ static podi_window *wayland_window_create(podi_application *app_generic, const c
         zxdg_toplevel_decoration_v1_set_mode(window->decoration, ZXDG_TOPLEVEL_DECORATION_V1_MODE_SERVER_SIDE);
         window->has_server_decorations = true;  // Assume we'll get server decorations
     } else {
-        printf("Podi: No decoration manager available - using client-side decorations\n");
-        fflush(stdout);
+        PODI_LOG_INFO("No decoration manager available - using client-side decorations");
         window->has_server_decorations = false;
         // Adjust surface size to include title bar (scale logical pixels to physical)
         window->common.height += (int)(PODI_TITLE_BAR_HEIGHT * window->common.scale_factor);
@@ -1254,9 +1688,12 @@ static podi_window *wayland_window_create(podi_application *app_generic, const c
 
     wl_surface_commit(window->surface);
     
+    PODI_TRACE_BEGIN("wayland_configure_wait");
     while (!window->configured) {
+        PODI_STAT_INC(&app->common, round_trips);
         wl_display_dispatch(app->display);
     }
+    PODI_TRACE_END("wayland_configure_wait");
     
     if (app->common.window_count >= app->common.window_capacity) {
         size_t new_capacity = app->common.window_capacity ? app->common.window_capacity * 2 : 4;
@@ -1273,6 +1710,7 @@ static podi_window *wayland_window_create(podi_application *app_generic, const c
         app->common.window_capacity = new_capacity;
     }
     
+    window->common.id = app->common.next_window_id++;
     app->common.windows[app->common.window_count++] = (podi_window *)window;
     
     return (podi_window *)window;
@@ -1287,6 +1725,11 @@ static void wayland_window_destroy(podi_window *window_generic) {
     }
 
     podi_application_wayland *app = window->app;
+    if (app->pointer_focus == window) app->pointer_focus = NULL;
+    if (app->keyboard_focus == window) {
+        app->keyboard_focus = NULL;
+        wayland_key_repeat_stop(app);
+    }
     
     for (size_t i = 0; i < app->common.window_count; i++) {
         if (app->common.windows[i] == window_generic) {
@@ -1327,6 +1770,7 @@ static void wayland_window_set_title(podi_window *window_generic, const char *ti
     free(window->common.title);
     window->common.title = strdup(title);
     xdg_toplevel_set_title(window->xdg_toplevel, title);
+    wayland_request_flush(window->app);
 }
 
 static void wayland_window_set_size(podi_window *window_generic, int width, int height) {
@@ -1439,12 +1883,10 @@ static bool wayland_window_get_wayland_handles(podi_window *window_generic, podi
     return true;
 }
 
-static void wayland_window_set_cursor(podi_window *window_generic, podi_cursor_shape cursor) {
-    podi_window_wayland *window = (podi_window_wayland *)window_generic;
-    if (!window || !window->app) return;
-
-    podi_application_wayland *app = window->app;
-    if (!app->cursor_theme || !app->cursor_surface || !app->pointer) return;
+// Returns the theme cursor for a shape, looking it up on first use
+static struct wl_cursor *wayland_get_cursor(podi_application_wayland *app, podi_cursor_shape cursor) {
+    if ((unsigned int)cursor >= PODI_CURSOR_SHAPE_COUNT) cursor = PODI_CURSOR_DEFAULT;
+    if (app->cursor_cache[cursor]) return app->cursor_cache[cursor];
 
     const char *cursor_name;
     switch (cursor) {
@@ -1478,19 +1920,37 @@ static void wayland_window_set_cursor(podi_window *window_generic, podi_cursor_s
             break;
     }
 
-    struct wl_cursor *wl_cursor = wl_cursor_theme_get_cursor(app->cursor_theme, cursor_name);
+    app->cursor_cache[cursor] = wl_cursor_theme_get_cursor(app->cursor_theme, cursor_name);
+    return app->cursor_cache[cursor];
+}
+
+static void wayland_window_set_cursor(podi_window *window_generic, podi_cursor_shape cursor) {
+    podi_window_wayland *window = (podi_window_wayland *)window_generic;
+    if (!window || !window->app) return;
+
+    podi_application_wayland *app = window->app;
+    if (!app->cursor_theme || !app->cursor_surface || !app->pointer) return;
+
+    // Resize handling sets the cursor on every motion; only changes reach the compositor
+    if (app->cursor_shape_set && app->cursor_shape == cursor) return;
+
+    struct wl_cursor *wl_cursor = wayland_get_cursor(app, cursor);
     if (!wl_cursor || wl_cursor->image_count == 0) return;
 
     struct wl_cursor_image *image = wl_cursor->images[0];
     struct wl_buffer *buffer = wl_cursor_image_get_buffer(image);
     if (!buffer) return;
 
+    PODI_STAT_INC(&app->common, cursor_uploads);
     wl_surface_attach(app->cursor_surface, buffer, 0, 0);
     wl_surface_damage(app->cursor_surface, 0, 0, image->width, image->height);
     wl_surface_commit(app->cursor_surface);
 
     wl_pointer_set_cursor(app->pointer, app->last_input_serial,
                          app->cursor_surface, image->hotspot_x, image->hotspot_y);
+    app->cursor_shape = cursor;
+    app->cursor_shape_set = true;
+    wayland_request_flush(app);
 }
 
 static void wayland_window_set_cursor_mode(podi_window *window_generic, bool locked, bool visible) {
@@ -1499,10 +1959,9 @@ static void wayland_window_set_cursor_mode(podi_window *window_generic, bool loc
 
     podi_application_wayland *app = window->app;
 
-    printf("DEBUG: Setting cursor mode - locked=%s, visible=%s, old_locked=%s\n",
-           locked ? "true" : "false", visible ? "true" : "false",
-           window->common.cursor_locked ? "true" : "false");
-    fflush(stdout);
+    PODI_LOG_DEBUG("Setting cursor mode - locked=%s, visible=%s, old_locked=%s",
+                   locked ? "true" : "false", visible ? "true" : "false",
+                   window->common.cursor_locked ? "true" : "false");
 
     window->common.cursor_locked = locked;
     window->common.cursor_visible = visible;
@@ -1520,9 +1979,8 @@ static void wayland_window_set_cursor_mode(podi_window *window_generic, bool loc
         // Hide cursor before requesting pointer constraints to ensure compositor applies it
         wayland_update_cursor_visibility(window);
 
-        printf("DEBUG: Setting cursor locked mode - protocols available: constraints=%p, relative=%p, pointer=%p\n",
-               (void*)app->pointer_constraints, (void*)app->relative_pointer_manager, (void*)app->pointer);
-        fflush(stdout);
+        PODI_LOG_DEBUG("Setting cursor locked mode - protocols available: constraints=%p, relative=%p, pointer=%p",
+                       (void*)app->pointer_constraints, (void*)app->relative_pointer_manager, (void*)app->pointer);
 
         // Create locked pointer and relative pointer if protocols are available
         if (app->pointer_constraints && app->relative_pointer_manager && app->pointer) {
@@ -1545,14 +2003,12 @@ static void wayland_window_set_cursor_mode(podi_window *window_generic, bool loc
                 ZWP_POINTER_CONSTRAINTS_V1_LIFETIME_PERSISTENT
             );
 
-            printf("DEBUG: Created locked pointer: %p\n", (void*)window->locked_pointer);
-            fflush(stdout);
+            PODI_LOG_DEBUG("Created locked pointer: %p", (void*)window->locked_pointer);
 
             // Add listener to get lock/unlock events
             if (window->locked_pointer) {
                 zwp_locked_pointer_v1_add_listener(window->locked_pointer, &locked_pointer_listener, window);
-                printf("DEBUG: Added locked pointer listener\n");
-                fflush(stdout);
+                PODI_LOG_DEBUG("Added locked pointer listener");
             }
 
             // Create relative pointer for delta motion events
@@ -1561,17 +2017,14 @@ static void wayland_window_set_cursor_mode(podi_window *window_generic, bool loc
                 app->pointer
             );
 
-            printf("DEBUG: Created relative pointer: %p\n", (void*)window->relative_pointer);
-            fflush(stdout);
+            PODI_LOG_DEBUG("Created relative pointer: %p", (void*)window->relative_pointer);
 
             if (window->relative_pointer) {
                 zwp_relative_pointer_v1_add_listener(window->relative_pointer, &relative_pointer_listener, window);
-                printf("DEBUG: Added relative pointer listener\n");
-                fflush(stdout);
+                PODI_LOG_DEBUG("Added relative pointer listener");
             }
         } else {
-            printf("DEBUG: Cannot lock cursor - missing protocols\n");
-            fflush(stdout);
+            PODI_LOG_DEBUG("Cannot lock cursor - missing protocols");
         }
     } else {
         // Unlock cursor - destroy pointer constraint objects
@@ -1615,7 +2068,7 @@ static void wayland_window_set_fullscreen_exclusive(podi_window *window_generic,
     }
 
     if (window->app->display) {
-        wl_display_flush(window->app->display);
+        wayland_request_flush(window->app);
     }
 }
 
@@ -1679,6 +2132,12 @@ const podi_platform_vtable wayland_vtable = {
     .application_should_close = wayland_application_should_close,
     .application_close = wayland_application_close,
     .application_poll_event = wayland_application_poll_event,
+    .application_poll_events = wayland_application_poll_events,
+    .application_wait_events = wayland_application_wait_events,
+    .application_get_fd = wayland_application_get_fd,
+    .application_prepare_read = wayland_application_prepare_read,
+    .application_dispatch_events = wayland_application_dispatch_events,
+    .application_flush = wayland_application_flush,
     .get_display_scale_factor = wayland_get_display_scale_factor,
     .window_create = wayland_window_create,
     .window_destroy = wayland_window_destroy,
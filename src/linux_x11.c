@@ -3,6 +3,7 @@
 #include "podi.h"
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <X11/XKBlib.h>
 #include <X11/keysym.h>
 #include <X11/Xresource.h>
 #include <X11/cursorfont.h>
@@ -34,6 +35,8 @@
 #include <stdio.h>
 #include <math.h>
 #include <time.h>
+#include <poll.h>
+#include <unistd.h>
 
 
 #define NET_WM_MOVERESIZE_SIZE_TOPLEFT     0
@@ -63,14 +66,23 @@ typedef struct {
     bool randr_available;
     int randr_event_base;
     int randr_error_base;
+    podi_clock_sync server_clock;
+    XContext window_context;  // Window -> podi_window_x11 for event routing
+    struct podi_window_x11 *raw_motion_window;  // Last window that received XI2 raw motion
+    uint8_t keys_down[32];  // Bitset of held keycodes, used to flag auto-repeat presses
+    bool pointer_moved;     // Motion or a resize since cursor bounds were last enforced
+    Cursor cursor_cache[PODI_CURSOR_SHAPE_COUNT];  // Font cursors, created on first use
+    int epoll_fd;  // Connection and wakeup fds, for external event loops
 } podi_application_x11;
 
-typedef struct {
+typedef struct podi_window_x11 {
     podi_window_common common;
     podi_application_x11 *app;
     Window window;
     XIC input_context;
     Cursor invisible_cursor;  // Store invisible cursor for cleanup
+    podi_cursor_shape cursor_shape;  // Shape defined on the window while cursor_shape_defined
+    bool cursor_shape_defined;
     bool has_focus;
     bool is_viewable;
     bool want_cursor_lock;
@@ -122,6 +134,27 @@ static void x11_disable_raw_motion(podi_window_x11 *window);
 static void x11_window_set_fullscreen_exclusive(podi_window *window_generic, bool enabled);
 static bool x11_window_is_fullscreen_exclusive(podi_window *window_generic);
 
+// Sends buffered requests to the server, counted for podi_application_get_stats()
+static void x11_flush(podi_application_x11 *app) {
+    PODI_STAT_INC(&app->common, flushes);
+    app->common.flush_pending = false;
+    XFlush(app->display);
+}
+
+// Setters flush right away unless the application opted into deferred
+// flushing; then their requests go out at the start of the next poll/wait
+static void x11_request_flush(podi_application_x11 *app) {
+    if (app->common.flush_deferred) {
+        app->common.flush_pending = true;
+    } else {
+        x11_flush(app);
+    }
+}
+
+static void x11_flush_pending(podi_application_x11 *app) {
+    if (app->common.flush_pending) x11_flush(app);
+}
+
 static void x11_request_window_focus(podi_window_x11 *window) {
     if (!window || !window->app) return;
 
@@ -149,7 +182,7 @@ static void x11_request_window_focus(podi_window_x11 *window) {
     }
 
     XRaiseWindow(display, window->window);
-    XFlush(display);
+    x11_request_flush(window->app);
 }
 
 static void x11_warp_pointer_to_center(podi_window_x11 *window) {
@@ -162,7 +195,8 @@ static void x11_warp_pointer_to_center(podi_window_x11 *window) {
     window->common.cursor_warping = true;
     XWarpPointer(display, None, window->window, 0, 0, 0, 0,
                  center_x, center_y);
-    XFlush(display);
+    // Not deferred: the next motion event is treated as this warp's echo
+    x11_flush(window->app);
 
     window->common.last_cursor_x = center_x;
     window->common.last_cursor_y = center_y;
@@ -179,6 +213,7 @@ static void x11_enforce_cursor_bounds(podi_window_x11 *window) {
     int root_x, root_y, win_x, win_y;
     unsigned int mask;
 
+    PODI_STAT_INC(&window->app->common, round_trips);
     if (!XQueryPointer(display, window->window, &root, &child,
                        &root_x, &root_y, &win_x, &win_y, &mask)) {
         x11_warp_pointer_to_center(window);
@@ -383,6 +418,12 @@ static podi_application *x11_application_create(void) {
     }
     
     app->screen = DefaultScreen(app->display);
+    app->window_context = XUniqueContext();
+
+    // Without this, held keys send a fake KeyRelease before every repeated
+    // KeyPress; with it only the presses repeat and x11_key_set_down spots them
+    Bool detectable_repeat = False;
+    XkbSetDetectableAutoRepeat(app->display, True, &detectable_repeat);
     app->wm_delete_window = XInternAtom(app->display, "WM_DELETE_WINDOW", False);
     app->net_wm_moveresize = XInternAtom(app->display, "_NET_WM_MOVERESIZE", False);
     app->net_active_window = XInternAtom(app->display, "_NET_ACTIVE_WINDOW", False);
@@ -423,14 +464,31 @@ static podi_application *x11_application_create(void) {
         if (XQueryExtension(app->display, "XInputExtension", &app->xi2_opcode,
                            &xi2_event_base, &xi2_error_base)) {
             app->xi2_available = true;
-            printf("XInput2 initialized successfully (opcode=%d, version=%d.%d)\n",
-                   app->xi2_opcode, xi2_major, xi2_minor);
+            PODI_LOG_INFO("XInput2 initialized successfully (opcode=%d, version=%d.%d)",
+                          app->xi2_opcode, xi2_major, xi2_minor);
         }
     }
 #else
-    printf("XInput2 not available at compile time - using XGrabPointer fallback\n");
+    PODI_LOG_INFO("XInput2 not available at compile time - using XGrabPointer fallback");
 #endif
 
+    if (!podi_wakeup_init(&app->common.wakeup)) {
+        if (app->input_method) XCloseIM(app->input_method);
+        XCloseDisplay(app->display);
+        free(app);
+        return NULL;
+    }
+
+    int fds[2] = { ConnectionNumber(app->display), app->common.wakeup.fd };
+    app->epoll_fd = podi_epoll_create(fds, 2);
+    if (app->epoll_fd < 0) {
+        podi_wakeup_destroy(&app->common.wakeup);
+        if (app->input_method) XCloseIM(app->input_method);
+        XCloseDisplay(app->display);
+        free(app);
+        return NULL;
+    }
+
     return (podi_application *)app;
 }
 
@@ -444,10 +502,17 @@ static void x11_application_destroy(podi_application *app_generic) {
         }
     }
     free(app->common.windows);
+    podi_event_queue_free(&app->common.events);
+    podi_wakeup_destroy(&app->common.wakeup);
+    close(app->epoll_fd);
     
     if (app->input_method) {
         XCloseIM(app->input_method);
     }
+
+    for (int i = 0; i < PODI_CURSOR_SHAPE_COUNT; i++) {
+        if (app->cursor_cache[i] != None) XFreeCursor(app->display, app->cursor_cache[i]);
+    }
     
     if (app->display) {
         XCloseDisplay(app->display);
@@ -465,89 +530,165 @@ static void x11_application_close(podi_application *app_generic) {
     if (app) app->common.should_close = true;
 }
 
-static bool x11_application_poll_event(podi_application *app_generic, podi_event *event) {
-    podi_application_x11 *app = (podi_application_x11 *)app_generic;
-    if (!app || !event) return false;
-    
+// Bounds checks cost an XQueryPointer round trip per locked window, so
+// they only run once the pointer may have left the center
+static void x11_update_cursor_locks(podi_application_x11 *app) {
+    bool enforce_bounds = app->pointer_moved;
+    app->pointer_moved = false;
+
     for (size_t i = 0; i < app->common.window_count; ++i) {
         podi_window_x11 *pending_window = (podi_window_x11 *)app->common.windows[i];
         if (pending_window) {
             x11_window_lock_cursor_if_ready(pending_window);
-            x11_enforce_cursor_bounds(pending_window);
+            if (enforce_bounds) x11_enforce_cursor_bounds(pending_window);
         }
     }
+}
 
-    if (!XPending(app->display)) return false;
-    
-    XEvent xevent;
-    XNextEvent(app->display, &xevent);
+static podi_window_x11 *x11_find_window(podi_application_x11 *app, Window xwindow) {
+    XPointer data = NULL;
+    if (XFindContext(app->display, xwindow, app->window_context, &data) != 0) {
+        return NULL;
+    }
+    return (podi_window_x11 *)data;
+}
 
-    // Let input method process the event first
-    if (XFilterEvent(&xevent, None)) {
-        return false;  // Event consumed by input method
+// Server timestamp of input events, or CurrentTime for events without one
+static Time x11_event_server_time(const XEvent *xevent) {
+    switch (xevent->type) {
+        case KeyPress:
+        case KeyRelease:
+            return xevent->xkey.time;
+        case ButtonPress:
+        case ButtonRelease:
+            return xevent->xbutton.time;
+        case MotionNotify:
+            return xevent->xmotion.time;
+        case EnterNotify:
+        case LeaveNotify:
+            return xevent->xcrossing.time;
+        default:
+            return CurrentTime;
     }
+}
 
-    podi_window_x11 *window = NULL;
-    for (size_t i = 0; i < app->common.window_count; i++) {
-        podi_window_x11 *w = (podi_window_x11 *)app->common.windows[i];
-        if (w && w->window == xevent.xany.window) {
-            window = w;
-            break;
+#ifdef X11_XI2_AVAILABLE
+static bool x11_translate_xi2_event(podi_application_x11 *app, XEvent *xevent, podi_event *event) {
+    if (xevent->xcookie.evtype != XI_RawMotion) return false;
+
+    // Raw events are selected on the root window, so route them to the
+    // window that holds the cursor lock; remember it so the scan only runs
+    // when the lock moves
+    podi_window_x11 *window = app->raw_motion_window;
+    if (!window || !window->common.cursor_locked) {
+        window = NULL;
+        for (size_t i = 0; i < app->common.window_count; i++) {
+            podi_window_x11 *w = (podi_window_x11 *)app->common.windows[i];
+            if (w && w->common.cursor_locked) {
+                window = w;
+                break;
+            }
         }
+        app->raw_motion_window = window;
     }
-    
     if (!window) return false;
-    
+
+    if (!XGetEventData(app->display, &xevent->xcookie)) return false;
+
+    XIRawEvent *raw = (XIRawEvent *)xevent->xcookie.data;
+    bool raw_mode = window->common.raw_motion;
+    app->pointer_moved = true;
+
+    // raw_values are the unaccelerated device deltas, valuators.values have
+    // pointer acceleration applied
+    double *values = raw_mode ? raw->raw_values : raw->valuators.values;
+    double delta_x = 0.0, delta_y = 0.0;
+
+    // Get delta values from valuators
+    if (raw->valuators.mask_len > 0) {
+        int valuator_index = 0;
+        for (int i = 0; i < 2 && i < raw->valuators.mask_len * 8; i++) {
+            if (XIMaskIsSet(raw->valuators.mask, i)) {
+                if (i == 0) delta_x = values[valuator_index];      // X axis
+                else if (i == 1) delta_y = values[valuator_index]; // Y axis
+                valuator_index++;
+            }
+        }
+    }
+
     event->window = (podi_window *)window;
+    event->timestamp_ns = podi_clock_sync_convert(&app->server_clock, (uint32_t)raw->time);
+    if (raw_mode) {
+        // Pointer bounds are enforced once per poll, not per device report
+        event->type = PODI_EVENT_MOUSE_RAW_MOTION;
+        event->raw_motion.delta_x = delta_x;
+        event->raw_motion.delta_y = delta_y;
+        event->raw_motion.device_time_us = (uint64_t)raw->time * 1000;
+    } else {
+        event->type = PODI_EVENT_MOUSE_MOVE;
+        event->mouse_move.x = window->common.cursor_center_x;
+        event->mouse_move.y = window->common.cursor_center_y;
+        event->mouse_move.delta_x = delta_x;
+        event->mouse_move.delta_y = delta_y;
 
-    // Handle XInput2 events (if available)
-#ifdef X11_XI2_AVAILABLE
-    if (xevent.type == GenericEvent && xevent.xcookie.extension == app->xi2_opcode) {
-        if (XGetEventData(app->display, &xevent.xcookie)) {
-            XIDeviceEvent *xidev = (XIDeviceEvent *)xevent.xcookie.data;
-
-            if (xevent.xcookie.evtype == XI_RawMotion && window->common.cursor_locked) {
-                XIRawEvent *raw = (XIRawEvent *)xevent.xcookie.data;
-
-                // Extract raw motion values
-                double *values = raw->valuators.values;
-                double delta_x = 0.0, delta_y = 0.0;
-
-                // Get raw delta values from valuators
-                if (raw->valuators.mask_len > 0) {
-                    int valuator_index = 0;
-                    for (int i = 0; i < 2 && i < raw->valuators.mask_len * 8; i++) {
-                        if (XIMaskIsSet(raw->valuators.mask, i)) {
-                            if (i == 0) delta_x = values[valuator_index];      // X axis
-                            else if (i == 1) delta_y = values[valuator_index]; // Y axis
-                            valuator_index++;
-                        }
-                    }
-                }
+        x11_enforce_cursor_bounds(window);
+    }
 
-                event->type = PODI_EVENT_MOUSE_MOVE;
-                event->mouse_move.x = window->common.cursor_center_x;
-                event->mouse_move.y = window->common.cursor_center_y;
-                event->mouse_move.delta_x = delta_x;
-                event->mouse_move.delta_y = delta_y;
+    XFreeEventData(app->display, &xevent->xcookie);
+    return true;
+}
+#endif
 
-                x11_enforce_cursor_bounds(window);
+// Records a key as held or released and reports whether it already was
+static bool x11_key_set_down(podi_application_x11 *app, unsigned int keycode, bool down) {
+    if (keycode >= sizeof(app->keys_down) * 8) return false;
 
-                XFreeEventData(app->display, &xevent.xcookie);
-                return true;
-            }
+    uint8_t bit = (uint8_t)(1u << (keycode % 8));
+    bool was_down = (app->keys_down[keycode / 8] & bit) != 0;
+    if (down) {
+        app->keys_down[keycode / 8] |= bit;
+    } else {
+        app->keys_down[keycode / 8] &= (uint8_t)~bit;
+    }
+    return was_down;
+}
 
-            XFreeEventData(app->display, &xevent.xcookie);
-        }
-        return false; // XI2 event but not one we care about
+// Most native events map to at most one podi event; a key press can also
+// produce text
+#define X11_MAX_TRANSLATED_EVENTS 2
+
+// Fills events with what xevent translates to and returns how many
+static size_t x11_translate_event(podi_application_x11 *app, XEvent *xevent, podi_event *events) {
+    podi_event *event = &events[0];
+
+    // Let input method process the event first
+    if (XFilterEvent(xevent, None)) {
+        PODI_STAT_INC(&app->common, events_filtered);
+        return 0;  // Event consumed by input method
+    }
+
+#ifdef X11_XI2_AVAILABLE
+    // Generic events carry no window, so handle them before the window lookup
+    if (xevent->type == GenericEvent && xevent->xcookie.extension == app->xi2_opcode) {
+        return x11_translate_xi2_event(app, xevent, event) ? 1 : 0;
     }
 #endif
 
-    switch (xevent.type) {
+    podi_window_x11 *window = x11_find_window(app, xevent->xany.window);
+    if (!window) return 0;
+    
+    event->window = (podi_window *)window;
+
+    Time server_time = x11_event_server_time(xevent);
+    if (server_time != CurrentTime) {
+        event->timestamp_ns = podi_clock_sync_convert(&app->server_clock, (uint32_t)server_time);
+    }
+
+    switch (xevent->type) {
         case ClientMessage:
-            if (xevent.xclient.data.l[0] == (long)app->wm_delete_window) {
+            if (xevent->xclient.data.l[0] == (long)app->wm_delete_window) {
                 event->type = PODI_EVENT_WINDOW_CLOSE;
-                return true;
+                return 1;
             }
             break;
 
@@ -557,7 +698,7 @@ static bool x11_application_poll_event(podi_application *app_generic, podi_event
                 window->pending_cursor_lock = true;
                 x11_window_lock_cursor_if_ready(window);
             }
-            return false;
+            return 0;
 
         case UnmapNotify:
             window->is_viewable = false;
@@ -567,166 +708,158 @@ static bool x11_application_poll_event(podi_application *app_generic, podi_event
             if (window->want_cursor_lock) {
                 window->pending_cursor_lock = true;
             }
-            return false;
+            return 0;
 
         case DestroyNotify:
             window->is_viewable = false;
             window->want_cursor_lock = false;
             window->pending_cursor_lock = false;
             x11_window_release_cursor(window);
-            return false;
+            return 0;
             
         case ConfigureNotify: {
             int old_width = window->common.width;
             int old_height = window->common.height;
 
-            window->common.width = xevent.xconfigure.width;
-            window->common.height = xevent.xconfigure.height;
-            window->common.x = xevent.xconfigure.x;
-            window->common.y = xevent.xconfigure.y;
+            window->common.width = xevent->xconfigure.width;
+            window->common.height = xevent->xconfigure.height;
+            window->common.x = xevent->xconfigure.x;
+            window->common.y = xevent->xconfigure.y;
 
-            if (xevent.xconfigure.width != old_width ||
-                xevent.xconfigure.height != old_height) {
+            if (xevent->xconfigure.width != old_width ||
+                xevent->xconfigure.height != old_height) {
                 // Update cursor center if cursor is locked
                 if (window->common.cursor_locked) {
                     window->common.cursor_center_x = window->common.width / 2.0;
                     window->common.cursor_center_y = window->common.height / 2.0;
+                    app->pointer_moved = true;
                 }
 
                 event->type = PODI_EVENT_WINDOW_RESIZE;
-                event->window_resize.width = xevent.xconfigure.width;
-                event->window_resize.height = xevent.xconfigure.height;
-                return true;
+                event->window_resize.width = xevent->xconfigure.width;
+                event->window_resize.height = xevent->xconfigure.height;
+                return 1;
             }
             break;
         }
             
         case KeyPress: {
-            KeySym keysym = XLookupKeysym(&xevent.xkey, 0);
+            KeySym keysym = XLookupKeysym(&xevent->xkey, 0);
             event->type = PODI_EVENT_KEY_DOWN;
             event->key.key = x11_keycode_to_podi_key(keysym);
-            event->key.native_keycode = xevent.xkey.keycode;
-            event->key.modifiers = x11_state_to_podi_modifiers(xevent.xkey.state);
-
-            // Use proper Unicode input with composition support
-            static char text_buffer[32];
-            text_buffer[0] = '\0';
-            event->key.text = NULL;
+            event->key.native_keycode = xevent->xkey.keycode;
+            event->key.modifiers = x11_state_to_podi_modifiers(xevent->xkey.state);
+            event->key.is_repeat = x11_key_set_down(app, xevent->xkey.keycode, true);
+
+            // The text, if any, follows the key as a separate event that
+            // owns its characters
+            if (!podi_window_accepts_event(event->window, PODI_EVENT_TEXT_INPUT)) {
+                return 1;
+            }
 
-            podi_window_x11 *window = (podi_window_x11 *)event->window;
+            char text[64];
             int len = 0;
             Status status;
 
             if (window && window->input_context) {
                 // Use Xutf8LookupString for proper Unicode and composition
-                len = Xutf8LookupString(window->input_context, &xevent.xkey,
-                                        text_buffer, sizeof(text_buffer) - 1,
-                                        NULL, &status);
+                len = Xutf8LookupString(window->input_context, &xevent->xkey,
+                                        text, sizeof(text) - 1, NULL, &status);
                 if (status == XBufferOverflow) {
-                    // Buffer too small, truncate
-                    len = sizeof(text_buffer) - 1;
+                    // Nothing is written on overflow; drop the oversized input
+                    len = 0;
                 }
             } else {
                 // Fallback to XLookupString if no input context
                 static XComposeStatus compose_status = {NULL, 0};
                 KeySym lookup_sym;
-                len = XLookupString(&xevent.xkey, text_buffer, sizeof(text_buffer) - 1,
+                len = XLookupString(&xevent->xkey, text, sizeof(text) - 1,
                                     &lookup_sym, &compose_status);
             }
 
-            if (len > 0) {
-                text_buffer[len] = '\0';
-                event->key.text = text_buffer;
+            if (len <= 0 || !podi_event_init_text_input(&events[1], event->window, text, (size_t)len)) {
+                return 1;
             }
-
-            return true;
+            events[1].timestamp_ns = event->timestamp_ns;
+            return 2;
         }
         
         case KeyRelease: {
-            KeySym keysym = XLookupKeysym(&xevent.xkey, 0);
+            KeySym keysym = XLookupKeysym(&xevent->xkey, 0);
             event->type = PODI_EVENT_KEY_UP;
             event->key.key = x11_keycode_to_podi_key(keysym);
-            event->key.native_keycode = xevent.xkey.keycode;
-            event->key.modifiers = x11_state_to_podi_modifiers(xevent.xkey.state);
-            event->key.text = NULL; // No text on key release
-            return true;
+            event->key.native_keycode = xevent->xkey.keycode;
+            event->key.modifiers = x11_state_to_podi_modifiers(xevent->xkey.state);
+            x11_key_set_down(app, xevent->xkey.keycode, false);
+            return 1;
         }
         
         case ButtonPress:
-            switch (xevent.xbutton.button) {
+            switch (xevent->xbutton.button) {
                 case Button1: case Button2: case Button3:
                     event->type = PODI_EVENT_MOUSE_BUTTON_DOWN;
-                    switch (xevent.xbutton.button) {
+                    switch (xevent->xbutton.button) {
                         case Button1: event->mouse_button.button = PODI_MOUSE_BUTTON_LEFT; break;
                         case Button2: event->mouse_button.button = PODI_MOUSE_BUTTON_MIDDLE; break;
                         case Button3: event->mouse_button.button = PODI_MOUSE_BUTTON_RIGHT; break;
                     }
                     // Let X11 window manager handle all resize operations natively
-                    return true;
+                    return 1;
                 case Button4:
                     event->type = PODI_EVENT_MOUSE_SCROLL;
                     event->mouse_scroll.x = 0.0;
                     event->mouse_scroll.y = 1.0;
-                    return true;
+                    return 1;
                 case Button5:
                     event->type = PODI_EVENT_MOUSE_SCROLL;
                     event->mouse_scroll.x = 0.0;
                     event->mouse_scroll.y = -1.0;
-                    return true;
+                    return 1;
                 case 6:
                     event->type = PODI_EVENT_MOUSE_SCROLL;
                     event->mouse_scroll.x = 1.0;
                     event->mouse_scroll.y = 0.0;
-                    return true;
+                    return 1;
                 case 7:
                     event->type = PODI_EVENT_MOUSE_SCROLL;
                     event->mouse_scroll.x = -1.0;
                     event->mouse_scroll.y = 0.0;
-                    return true;
-                default: return false;
+                    return 1;
+                default: return 0;
             }
             
         case ButtonRelease:
             event->type = PODI_EVENT_MOUSE_BUTTON_UP;
-            switch (xevent.xbutton.button) {
+            switch (xevent->xbutton.button) {
                 case Button1: event->mouse_button.button = PODI_MOUSE_BUTTON_LEFT; break;
                 case Button2: event->mouse_button.button = PODI_MOUSE_BUTTON_MIDDLE; break;
                 case Button3: event->mouse_button.button = PODI_MOUSE_BUTTON_RIGHT; break;
-                default: return false;
+                default: return 0;
             }
             // Let X11 window manager handle all resize operations natively
-            return true;
+            return 1;
             
         case MotionNotify: {
             event->type = PODI_EVENT_MOUSE_MOVE;
+            app->pointer_moved = true;
 
-            // Find the window for cursor locking check
-            podi_window_x11 *podi_window = NULL;
-            for (size_t i = 0; i < app->common.window_count; i++) {
-                podi_window_x11 *win = (podi_window_x11*)app->common.windows[i];
-                if (win->window == xevent.xmotion.window) {
-                    podi_window = win;
-                    break;
-                }
-            }
-
-            int motion_x = xevent.xmotion.x;
-            int motion_y = xevent.xmotion.y;
+            int motion_x = xevent->xmotion.x;
+            int motion_y = xevent->xmotion.y;
 
-            if (podi_window && podi_window->common.cursor_warping) {
-                podi_window->common.cursor_warping = false;
-                podi_window->common.last_cursor_x = motion_x;
-                podi_window->common.last_cursor_y = motion_y;
+            if (window->common.cursor_warping) {
+                window->common.cursor_warping = false;
+                window->common.last_cursor_x = motion_x;
+                window->common.last_cursor_y = motion_y;
                 if (!app->xi2_available) {
-                    return false;
+                    return 0;
                 }
             }
 
-            if (podi_window && podi_window->common.cursor_locked && !app->xi2_available) {
+            if (window->common.cursor_locked && !app->xi2_available) {
                 // Only use old XWarpPointer method when XInput2 is not available
                 // Calculate deltas from actual mouse position to center
-                double center_x = podi_window->common.cursor_center_x;
-                double center_y = podi_window->common.cursor_center_y;
+                double center_x = window->common.cursor_center_x;
+                double center_y = window->common.cursor_center_y;
                 double delta_x = motion_x - center_x;
                 double delta_y = motion_y - center_y;
 
@@ -737,33 +870,27 @@ static bool x11_application_poll_event(podi_application *app_generic, podi_event
                 event->mouse_move.delta_y = delta_y;
 
                 // Always warp back to center when locked (aggressive warping)
-                x11_warp_pointer_to_center(podi_window);
-            } else if (podi_window && podi_window->common.cursor_locked && app->xi2_available) {
+                x11_warp_pointer_to_center(window);
+            } else if (window->common.cursor_locked && app->xi2_available) {
                 // When XInput2 is available and cursor is locked, ignore regular motion events
                 // XI_RawMotion events will handle relative motion instead
-                podi_window->common.last_cursor_x = motion_x;
-                podi_window->common.last_cursor_y = motion_y;
-                return false;
+                window->common.last_cursor_x = motion_x;
+                window->common.last_cursor_y = motion_y;
+                return 0;
             } else {
                 // Normal unlocked mode - report actual position and calculate deltas from last position
                 event->mouse_move.x = motion_x;
                 event->mouse_move.y = motion_y;
 
-                if (podi_window) {
-                    event->mouse_move.delta_x = motion_x - podi_window->common.last_cursor_x;
-                    event->mouse_move.delta_y = motion_y - podi_window->common.last_cursor_y;
-
-                    // Update last position
-                    podi_window->common.last_cursor_x = motion_x;
-                    podi_window->common.last_cursor_y = motion_y;
-                } else {
-                    // Fallback if window not found
-                    event->mouse_move.delta_x = 0.0;
-                    event->mouse_move.delta_y = 0.0;
-                }
+                event->mouse_move.delta_x = motion_x - window->common.last_cursor_x;
+                event->mouse_move.delta_y = motion_y - window->common.last_cursor_y;
+
+                // Update last position
+                window->common.last_cursor_x = motion_x;
+                window->common.last_cursor_y = motion_y;
             }
 
-            return true;
+            return 1;
         }
             
         case FocusIn:
@@ -773,17 +900,19 @@ static bool x11_application_poll_event(podi_application *app_generic, podi_event
                 x11_window_lock_cursor_if_ready(window);
             }
             event->type = PODI_EVENT_WINDOW_FOCUS;
-            return true;
+            return 1;
             
         case FocusOut: {
             bool focus_lost_to_other_window =
-                (xevent.xfocus.mode == NotifyNormal || xevent.xfocus.mode == NotifyUngrab) &&
-                (xevent.xfocus.detail == NotifyAncestor ||
-                 xevent.xfocus.detail == NotifyNonlinear ||
-                 xevent.xfocus.detail == NotifyNonlinearVirtual);
+                (xevent->xfocus.mode == NotifyNormal || xevent->xfocus.mode == NotifyUngrab) &&
+                (xevent->xfocus.detail == NotifyAncestor ||
+                 xevent->xfocus.detail == NotifyNonlinear ||
+                 xevent->xfocus.detail == NotifyNonlinearVirtual);
 
             if (focus_lost_to_other_window) {
                 window->has_focus = false;
+                // Releases while unfocused go elsewhere, so forget held keys
+                memset(app->keys_down, 0, sizeof(app->keys_down));
             }
 
             if (window->common.cursor_locked && focus_lost_to_other_window) {
@@ -795,51 +924,160 @@ static bool x11_application_poll_event(podi_application *app_generic, podi_event
             }
 
             event->type = PODI_EVENT_WINDOW_UNFOCUS;
-            return true;
+            return 1;
         }
 
         case EnterNotify: {
-            // Find window and check if cursor is locked
-            podi_window_x11 *window = NULL;
-            for (size_t i = 0; i < app->common.window_count; i++) {
-                podi_window_x11 *win = (podi_window_x11*)app->common.windows[i];
-                if (win->window == xevent.xany.window) {
-                    window = win;
-                    break;
-                }
-            }
-
             // Skip enter events when cursor is locked
-            if (window && window->common.cursor_locked) {
-                return false;
+            if (window->common.cursor_locked) {
+                return 0;
             }
 
             event->type = PODI_EVENT_MOUSE_ENTER;
-            return true;
+            return 1;
         }
 
         case LeaveNotify: {
-            // Find window and check if cursor is locked
-            podi_window_x11 *window = NULL;
-            for (size_t i = 0; i < app->common.window_count; i++) {
-                podi_window_x11 *win = (podi_window_x11*)app->common.windows[i];
-                if (win->window == xevent.xany.window) {
-                    window = win;
-                    break;
-                }
-            }
-
             // Skip leave events when cursor is locked
-            if (window && window->common.cursor_locked) {
-                return false;
+            if (window->common.cursor_locked) {
+                return 0;
             }
 
             event->type = PODI_EVENT_MOUSE_LEAVE;
-            return true;
+            return 1;
         }
     }
 
-    return false;
+    return 0;
+}
+
+// Translates everything Xlib has already read into the common queue,
+// without touching the connection
+static void x11_queue_pending_events(podi_application_x11 *app) {
+    PODI_STAT_TIMER_START(dispatch_start);
+    while (XEventsQueued(app->display, QueuedAlready) > 0) {
+        XEvent xevent;
+        XNextEvent(app->display, &xevent);
+        podi_event events[X11_MAX_TRANSLATED_EVENTS] = {0};
+        size_t count = x11_translate_event(app, &xevent, events);
+        for (size_t i = 0; i < count; i++) {
+            podi_application_push_event(&app->common, &events[i]);
+        }
+    }
+    PODI_STAT_TIMER_STOP(&app->common, dispatch_ns, dispatch_start);
+}
+
+static bool x11_application_poll_event(podi_application *app_generic, podi_event *event) {
+    podi_application_x11 *app = (podi_application_x11 *)app_generic;
+    if (!app || !event) return false;
+
+    x11_update_cursor_locks(app);
+    x11_flush_pending(app);
+
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    if (app->common.events.count == 0 && XPending(app->display)) {
+        x11_queue_pending_events(app);
+    }
+    return podi_event_queue_pop(&app->common.events, event);
+}
+
+static size_t x11_application_poll_events(podi_application *app_generic, podi_event *events, size_t capacity) {
+    podi_application_x11 *app = (podi_application_x11 *)app_generic;
+    if (!app || !events || capacity == 0) return 0;
+
+    x11_update_cursor_locks(app);
+    x11_flush_pending(app);
+
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+
+    // Read whatever the socket already holds once, then translate Xlib's
+    // queue without flushing or touching the connection again
+    if (app->common.events.count < capacity && XEventsQueued(app->display, QueuedAfterReading) > 0) {
+        x11_queue_pending_events(app);
+    }
+    return podi_event_queue_pop_many(&app->common.events, events, capacity);
+}
+
+static bool x11_application_wait_events(podi_application *app_generic, int64_t timeout_ns) {
+    podi_application_x11 *app = (podi_application_x11 *)app_generic;
+    if (!app) return false;
+
+    x11_flush_pending(app);
+    uint64_t delivered = app->common.delivered_count;
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    if (podi_application_has_events(&app->common, delivered)) return true;
+
+    // XPending flushes our requests and picks up anything already readable
+    if (XPending(app->display)) return true;
+
+    uint64_t start = podi_time_now_ns();
+    int64_t remaining = timeout_ns;
+
+    while (true) {
+        struct pollfd pfds[2] = {
+            { .fd = ConnectionNumber(app->display), .events = POLLIN },
+            { .fd = app->common.wakeup.fd, .events = POLLIN },
+        };
+        int ready = podi_poll(pfds, 2, remaining);
+        if (ready < 0 || (pfds[0].revents & (POLLERR | POLLHUP))) return false;
+
+        if (pfds[1].revents & POLLIN) {
+            podi_wakeup_acknowledge(&app->common.wakeup);
+            podi_wakeup_drain(&app->common.wakeup, &app->common);
+            if (podi_application_has_events(&app->common, delivered)) return true;
+        }
+
+        // Readable data may be a partial event or only replies, so re-check
+        if ((pfds[0].revents & POLLIN) && XEventsQueued(app->display, QueuedAfterReading) > 0) return true;
+
+        if (timeout_ns >= 0) {
+            uint64_t elapsed = podi_time_now_ns() - start;
+            if (elapsed >= (uint64_t)timeout_ns) return false;
+            remaining = timeout_ns - (int64_t)elapsed;
+        }
+    }
+}
+
+static int x11_application_get_fd(podi_application *app_generic) {
+    podi_application_x11 *app = (podi_application_x11 *)app_generic;
+    if (!app) return -1;
+    return app->epoll_fd;
+}
+
+static bool x11_application_prepare_read(podi_application *app_generic) {
+    podi_application_x11 *app = (podi_application_x11 *)app_generic;
+    if (!app) return false;
+
+    x11_flush_pending(app);
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+    if (app->common.events.count > 0) return false;
+
+    // Flushes our requests; events already buffered by Xlib won't wake the fd
+    return XEventsQueued(app->display, QueuedAfterFlush) == 0;
+}
+
+static bool x11_application_dispatch_events(podi_application *app_generic, bool fd_readable) {
+    podi_application_x11 *app = (podi_application_x11 *)app_generic;
+    if (!app) return false;
+
+    x11_update_cursor_locks(app);
+    x11_flush_pending(app);
+
+    if (fd_readable) {
+        // Either member may have woken the epoll descriptor; both reads
+        // below return at once when theirs has nothing
+        podi_wakeup_acknowledge(&app->common.wakeup);
+        podi_wakeup_drain(&app->common.wakeup, &app->common);
+        XEventsQueued(app->display, QueuedAfterReading);
+    }
+
+    x11_queue_pending_events(app);
+    return true;
+}
+
+static void x11_application_flush(podi_application *app_generic) {
+    podi_application_x11 *app = (podi_application_x11 *)app_generic;
+    if (app) x11_flush(app);
 }
 
 static float x11_get_scale_factor(podi_application_x11 *app) {
@@ -917,6 +1155,28 @@ static float x11_get_display_scale_factor(podi_application *app_generic) {
     return x11_get_scale_factor(app);
 }
 
+// Core event mask for a window. Structure, focus and expose events are
+// always selected because window state tracking depends on them
+static long x11_window_input_mask(podi_window_x11 *window) {
+    podi_window *w = (podi_window *)window;
+    long mask = ExposureMask | StructureNotifyMask | FocusChangeMask;
+
+    // Releases stay selected with presses: they clear the held-key bitset
+    // behind is_repeat; an unwanted KEY_UP is dropped by the common layer
+    if (podi_window_accepts_event(w, PODI_EVENT_KEY_DOWN) ||
+        podi_window_accepts_event(w, PODI_EVENT_TEXT_INPUT) ||
+        podi_window_accepts_event(w, PODI_EVENT_KEY_UP)) mask |= KeyPressMask | KeyReleaseMask;
+    // Scroll wheels report as buttons 4-7; releases stay selected with
+    // presses so the held-button state is cleared
+    if (podi_window_accepts_event(w, PODI_EVENT_MOUSE_BUTTON_DOWN) ||
+        podi_window_accepts_event(w, PODI_EVENT_MOUSE_BUTTON_UP) ||
+        podi_window_accepts_event(w, PODI_EVENT_MOUSE_SCROLL)) mask |= ButtonPressMask | ButtonReleaseMask;
+    if (podi_window_accepts_event(w, PODI_EVENT_MOUSE_MOVE)) mask |= PointerMotionMask;
+    if (podi_window_accepts_event(w, PODI_EVENT_MOUSE_ENTER)) mask |= EnterWindowMask;
+    if (podi_window_accepts_event(w, PODI_EVENT_MOUSE_LEAVE)) mask |= LeaveWindowMask;
+    return mask;
+}
+
 static podi_window *x11_window_create(podi_application *app_generic, const char *title, int width, int height) {
     podi_application_x11 *app = (podi_application_x11 *)app_generic;
     if (!app) return NULL;
@@ -962,9 +1222,7 @@ static podi_window *x11_window_create(podi_application *app_generic, const char
 
     XSetWindowAttributes attrs = {0};
     attrs.background_pixmap = None;
-    attrs.event_mask = ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask |
-                       ButtonReleaseMask | PointerMotionMask | StructureNotifyMask |
-                       FocusChangeMask | EnterWindowMask | LeaveWindowMask;
+    attrs.event_mask = x11_window_input_mask(window);
     attrs.bit_gravity = StaticGravity;
     attrs.win_gravity = StaticGravity;
 
@@ -993,13 +1251,10 @@ static podi_window *x11_window_create(podi_application *app_generic, const char
     XSetWMProtocols(app->display, window->window, &app->wm_delete_window, 1);
     XStoreName(app->display, window->window, window->common.title);
     
-    XSelectInput(app->display, window->window,
-                 ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask |
-                 ButtonReleaseMask | PointerMotionMask | StructureNotifyMask |
-                 FocusChangeMask | EnterWindowMask | LeaveWindowMask);
+    XSelectInput(app->display, window->window, x11_window_input_mask(window));
     
     XMapWindow(app->display, window->window);
-    XFlush(app->display);
+    x11_flush(app);
 
     // Create input context for proper composition support
     if (app->input_method) {
@@ -1024,7 +1279,9 @@ static podi_window *x11_window_create(podi_application *app_generic, const char
         app->common.window_capacity = new_capacity;
     }
     
+    window->common.id = app->common.next_window_id++;
     app->common.windows[app->common.window_count++] = (podi_window *)window;
+    XSaveContext(app->display, window->window, app->window_context, (XPointer)window);
     
     return (podi_window *)window;
 }
@@ -1038,6 +1295,9 @@ static void x11_window_destroy(podi_window *window_generic) {
     }
 
     podi_application_x11 *app = window->app;
+    if (app->raw_motion_window == window) {
+        app->raw_motion_window = NULL;
+    }
 
     for (size_t i = 0; i < app->common.window_count; i++) {
         if (app->common.windows[i] == window_generic) {
@@ -1061,11 +1321,20 @@ static void x11_window_destroy(podi_window *window_generic) {
         XDestroyIC(window->input_context);
     }
 
+    XDeleteContext(app->display, window->window, app->window_context);
     XDestroyWindow(app->display, window->window);
     free(window->common.title);
     free(window);
 }
 
+static void x11_window_set_event_mask(podi_window *window_generic) {
+    podi_window_x11 *window = (podi_window_x11 *)window_generic;
+    if (!window) return;
+
+    XSelectInput(window->app->display, window->window, x11_window_input_mask(window));
+    x11_request_flush(window->app);
+}
+
 static void x11_window_close(podi_window *window_generic) {
     podi_window_x11 *window = (podi_window_x11 *)window_generic;
     if (window) window->common.should_close = true;
@@ -1078,7 +1347,7 @@ static void x11_window_set_title(podi_window *window_generic, const char *title)
     free(window->common.title);
     window->common.title = strdup(title);
     XStoreName(window->app->display, window->window, title);
-    XFlush(window->app->display);
+    x11_request_flush(window->app);
 }
 
 static void x11_window_set_size(podi_window *window_generic, int width, int height) {
@@ -1097,7 +1366,7 @@ static void x11_window_set_size(podi_window *window_generic, int width, int heig
     size_hints.min_width = 100;
     size_hints.min_height = 100;
     XSetWMNormalHints(window->app->display, window->window, &size_hints);
-    XFlush(window->app->display);
+    x11_request_flush(window->app);
 }
 
 static void x11_window_set_position_and_size(podi_window *window_generic, int x, int y, int width, int height) {
@@ -1116,7 +1385,7 @@ static void x11_window_set_position_and_size(podi_window *window_generic, int x,
     size_hints.min_width = 100;
     size_hints.min_height = 100;
     XSetWMNormalHints(window->app->display, window->window, &size_hints);
-    XFlush(window->app->display);
+    x11_request_flush(window->app);
 }
 
 static void x11_window_get_size(podi_window *window_generic, int *width, int *height) {
@@ -1161,40 +1430,51 @@ static bool x11_window_get_wayland_handles(podi_window *window_generic, podi_way
     return false;
 }
 
-static void x11_window_set_cursor(podi_window *window_generic, podi_cursor_shape cursor) {
-    podi_window_x11 *window = (podi_window_x11 *)window_generic;
-    if (!window) return;
-
-    Display *display = window->app->display;
-    Window xwindow = window->window;
+// Returns the application's font cursor for a shape, creating it on first use
+static Cursor x11_get_cursor(podi_application_x11 *app, podi_cursor_shape cursor) {
+    if ((unsigned int)cursor >= PODI_CURSOR_SHAPE_COUNT) cursor = PODI_CURSOR_DEFAULT;
+    if (app->cursor_cache[cursor] != None) return app->cursor_cache[cursor];
 
-    Cursor x11_cursor;
+    unsigned int glyph;
     switch (cursor) {
         case PODI_CURSOR_RESIZE_N:
         case PODI_CURSOR_RESIZE_S:
-            x11_cursor = XCreateFontCursor(display, XC_sb_v_double_arrow);
+            glyph = XC_sb_v_double_arrow;
             break;
         case PODI_CURSOR_RESIZE_E:
         case PODI_CURSOR_RESIZE_W:
-            x11_cursor = XCreateFontCursor(display, XC_sb_h_double_arrow);
+            glyph = XC_sb_h_double_arrow;
             break;
         case PODI_CURSOR_RESIZE_NE:
         case PODI_CURSOR_RESIZE_SW:
-            x11_cursor = XCreateFontCursor(display, XC_top_right_corner);
+            glyph = XC_top_right_corner;
             break;
         case PODI_CURSOR_RESIZE_NW:
         case PODI_CURSOR_RESIZE_SE:
-            x11_cursor = XCreateFontCursor(display, XC_top_left_corner);
+            glyph = XC_top_left_corner;
             break;
         case PODI_CURSOR_DEFAULT:
         default:
-            x11_cursor = XCreateFontCursor(display, XC_left_ptr);
+            glyph = XC_left_ptr;
             break;
     }
 
-    XDefineCursor(display, xwindow, x11_cursor);
-    XFreeCursor(display, x11_cursor);
-    XFlush(display);
+    PODI_STAT_INC(&app->common, cursor_uploads);
+    app->cursor_cache[cursor] = XCreateFontCursor(app->display, glyph);
+    return app->cursor_cache[cursor];
+}
+
+static void x11_window_set_cursor(podi_window *window_generic, podi_cursor_shape cursor) {
+    podi_window_x11 *window = (podi_window_x11 *)window_generic;
+    if (!window) return;
+
+    // Resize handling sets the cursor on every motion; only changes reach the server
+    if (window->cursor_shape_defined && window->cursor_shape == cursor) return;
+
+    XDefineCursor(window->app->display, window->window, x11_get_cursor(window->app, cursor));
+    window->cursor_shape = cursor;
+    window->cursor_shape_defined = true;
+    x11_request_flush(window->app);
 }
 
 #ifdef X11_XI2_AVAILABLE
@@ -1216,11 +1496,11 @@ static bool x11_enable_raw_motion(podi_window_x11 *window) {
                        DefaultRootWindow(window->app->display),
                        &mask, 1) == Success) {
         window->xi2_raw_motion_selected = true;
-        printf("DEBUG: XInput2 XI_RawMotion events enabled for relative mouse mode\n");
+        PODI_LOG_DEBUG("XInput2 XI_RawMotion events enabled for relative mouse mode");
         return true;
     }
 
-    printf("ERROR: Failed to enable XInput2 XI_RawMotion events\n");
+    PODI_LOG_ERROR("Failed to enable XInput2 XI_RawMotion events");
     return false;
 }
 
@@ -1240,7 +1520,7 @@ static void x11_disable_raw_motion(podi_window_x11 *window) {
                    DefaultRootWindow(window->app->display),
                    &mask, 1);
     window->xi2_raw_motion_selected = false;
-    printf("DEBUG: XInput2 XI_RawMotion events disabled\n");
+    PODI_LOG_DEBUG("XInput2 XI_RawMotion events disabled");
 }
 #endif
 
@@ -1263,7 +1543,7 @@ static void x11_window_release_cursor(podi_window_x11 *window) {
     window->common.cursor_warping = false;
 
     if (had_grab || had_raw_motion) {
-        XFlush(window->app->display);
+        x11_request_flush(window->app);
     }
 }
 
@@ -1290,7 +1570,9 @@ static void x11_window_lock_cursor_if_ready(podi_window_x11 *window) {
     int grab_result = GrabSuccess;
     bool grab_established = false;
 
+    PODI_TRACE_BEGIN("x11_cursor_grab");
     for (int attempt = 0; attempt < max_attempts; ++attempt) {
+        PODI_STAT_INC(&window->app->common, round_trips);
         grab_result = XGrabPointer(
             display, xwindow, True,
             PointerMotionMask | ButtonPressMask | ButtonReleaseMask,
@@ -1307,13 +1589,14 @@ static void x11_window_lock_cursor_if_ready(podi_window_x11 *window) {
             XUngrabPointer(display, CurrentTime);
         }
 
-        printf("WARNING: XGrabPointer failed: %d (attempt %d)\n", grab_result, attempt + 1);
+        PODI_LOG_WARNING("XGrabPointer failed: %d (attempt %d)", grab_result, attempt + 1);
 
         struct timespec wait_time;
         wait_time.tv_sec = 0;
         wait_time.tv_nsec = 2000000L * (attempt + 1); // 2ms, 4ms, ...
         nanosleep(&wait_time, NULL);
     }
+    PODI_TRACE_END("x11_cursor_grab");
 
     if (!grab_established) {
         window->pending_cursor_lock = true;
@@ -1329,8 +1612,8 @@ static void x11_window_lock_cursor_if_ready(podi_window_x11 *window) {
 
     x11_warp_pointer_to_center(window);
 
-    printf("DEBUG: Pointer grab established (raw motion %s)\n",
-           window->xi2_raw_motion_selected ? "enabled" : "disabled");
+    PODI_LOG_DEBUG("Pointer grab established (raw motion %s)",
+                   window->xi2_raw_motion_selected ? "enabled" : "disabled");
 }
 
 static void x11_window_set_cursor_mode(podi_window *window_generic, bool locked, bool visible) {
@@ -1357,11 +1640,13 @@ static void x11_window_set_cursor_mode(podi_window *window_generic, bool locked,
             Pixmap blank = XCreateBitmapFromData(display, xwindow, &data, 1, 1);
             XColor dummy = {0};
             window->invisible_cursor = XCreatePixmapCursor(display, blank, blank, &dummy, &dummy, 0, 0);
+            PODI_STAT_INC(&window->app->common, cursor_uploads);
             XFreePixmap(display, blank);
         }
 
         // Set invisible cursor on window
         XDefineCursor(display, xwindow, window->invisible_cursor);
+        window->cursor_shape_defined = false;
         x11_window_lock_cursor_if_ready(window);
     } else {
         window->want_cursor_lock = false;
@@ -1376,7 +1661,9 @@ static void x11_window_set_cursor_mode(podi_window *window_generic, bool locked,
             Pixmap blank = XCreateBitmapFromData(display, xwindow, &data, 1, 1);
             XColor dummy = {0};
             Cursor temp_invisible = XCreatePixmapCursor(display, blank, blank, &dummy, &dummy, 0, 0);
+            PODI_STAT_INC(&window->app->common, cursor_uploads);
             XDefineCursor(display, xwindow, temp_invisible);
+            window->cursor_shape_defined = false;
             XFreeCursor(display, temp_invisible);
             XFreePixmap(display, blank);
         } else {
@@ -1385,7 +1672,7 @@ static void x11_window_set_cursor_mode(podi_window *window_generic, bool locked,
         }
     }
 
-    XFlush(display);
+    x11_request_flush(window->app);
 }
 
 static void x11_window_get_cursor_position(podi_window *window_generic, double *x, double *y) {
@@ -1398,6 +1685,7 @@ static void x11_window_get_cursor_position(podi_window *window_generic, double *
     int root_x, root_y, win_x, win_y;
     unsigned int mask;
 
+    PODI_STAT_INC(&window->app->common, round_trips);
     if (XQueryPointer(display, xwindow, &root, &child, &root_x, &root_y, &win_x, &win_y, &mask)) {
         *x = (double)win_x;
         *y = (double)win_y;
@@ -1423,6 +1711,7 @@ static void x11_window_set_fullscreen_exclusive(podi_window *window_generic, boo
         }
 
         XWindowAttributes attrs;
+        PODI_STAT_INC(&window->app->common, round_trips);
         if (XGetWindowAttributes(display, window->window, &attrs)) {
             window->common.restore_geometry_valid = true;
             window->common.restore_x = attrs.x;
@@ -1435,6 +1724,7 @@ static void x11_window_set_fullscreen_exclusive(podi_window *window_generic, boo
 
 #if PODI_HAS_XRANDR
         if (app->randr_available) {
+            PODI_TRACE_BEGIN("x11_randr_mode_set");
             XRRScreenResources *resources = g_xrandr.get_screen_resources_current(display, root);
             if (resources) {
                 RROutput output = g_xrandr.get_output_primary(display, root);
@@ -1491,6 +1781,7 @@ static void x11_window_set_fullscreen_exclusive(podi_window *window_generic, boo
 
                 g_xrandr.free_screen_resources(resources);
             }
+            PODI_TRACE_END("x11_randr_mode_set");
         } else {
             window->restore_crtc_valid = false;
         }
@@ -1519,6 +1810,7 @@ static void x11_window_set_fullscreen_exclusive(podi_window *window_generic, boo
 
 #if PODI_HAS_XRANDR
         if (app->randr_available && window->restore_crtc_valid) {
+            PODI_TRACE_BEGIN("x11_randr_mode_restore");
             XRRScreenResources *resources = g_xrandr.get_screen_resources_current(display, root);
             if (resources) {
                 RROutput outputs[] = { window->fullscreen_output };
@@ -1529,6 +1821,7 @@ static void x11_window_set_fullscreen_exclusive(podi_window *window_generic, boo
                 g_xrandr.free_screen_resources(resources);
             }
             window->restore_crtc_valid = false;
+            PODI_TRACE_END("x11_randr_mode_restore");
         }
 #else
         window->restore_crtc_valid = false;
@@ -1545,7 +1838,7 @@ static void x11_window_set_fullscreen_exclusive(podi_window *window_generic, boo
         window->common.fullscreen_exclusive = false;
     }
 
-    XFlush(display);
+    x11_request_flush(window->app);
 }
 
 static bool x11_window_is_fullscreen_exclusive(podi_window *window_generic) {
@@ -1580,6 +1873,12 @@ const podi_platform_vtable x11_vtable = {
     .application_should_close = x11_application_should_close,
     .application_close = x11_application_close,
     .application_poll_event = x11_application_poll_event,
+    .application_poll_events = x11_application_poll_events,
+    .application_wait_events = x11_application_wait_events,
+    .application_get_fd = x11_application_get_fd,
+    .application_prepare_read = x11_application_prepare_read,
+    .application_dispatch_events = x11_application_dispatch_events,
+    .application_flush = x11_application_flush,
     .get_display_scale_factor = x11_get_display_scale_factor,
     .window_create = x11_window_create,
     .window_destroy = x11_window_destroy,
@@ -1600,6 +1899,7 @@ const podi_platform_vtable x11_vtable = {
     .window_set_fullscreen_exclusive = x11_window_set_fullscreen_exclusive,
     .window_is_fullscreen_exclusive = x11_window_is_fullscreen_exclusive,
     .window_get_title_bar_height = x11_window_get_title_bar_height,
+    .window_set_event_mask = x11_window_set_event_mask,
 #ifdef PODI_PLATFORM_LINUX
     .window_get_x11_handles = x11_window_get_x11_handles,
     .window_get_wayland_handles = x11_window_get_wayland_handles,
@@ -0,0 +1,65 @@
+#include "internal.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// Longer messages are truncated; podi's own messages are far shorter
+#define PODI_LOG_MESSAGE_MAX 512
+
+static podi_log_callback log_callback = NULL;
+static void *log_callback_user_data = NULL;
+
+// -1 until the first message reads PODI_LOG_LEVEL or podi_set_log_level() is called
+static atomic_int log_level = -1;
+
+static const char *podi_log_level_name(podi_log_level level) {
+    switch (level) {
+        case PODI_LOG_LEVEL_ERROR: return "error";
+        case PODI_LOG_LEVEL_WARNING: return "warning";
+        case PODI_LOG_LEVEL_INFO: return "info";
+        case PODI_LOG_LEVEL_DEBUG: return "debug";
+    }
+    return "unknown";
+}
+
+static int podi_log_default_level(void) {
+    const char *env = getenv("PODI_LOG_LEVEL");
+    if (env) {
+        for (int level = PODI_LOG_LEVEL_ERROR; level <= PODI_LOG_LEVEL_DEBUG; level++) {
+            if (strcasecmp(env, podi_log_level_name((podi_log_level)level)) == 0) return level;
+        }
+    }
+    return PODI_LOG_LEVEL_WARNING;
+}
+
+void podi_set_log_callback(podi_log_callback callback, void *user_data) {
+    log_callback = callback;
+    log_callback_user_data = user_data;
+}
+
+void podi_set_log_level(podi_log_level level) {
+    atomic_store(&log_level, (int)level);
+}
+
+void podi_log(podi_log_level level, const char *format, ...) {
+    int threshold = atomic_load(&log_level);
+    if (threshold < 0) {
+        threshold = podi_log_default_level();
+        atomic_store(&log_level, threshold);
+    }
+    if ((int)level > threshold) return;
+
+    char message[PODI_LOG_MESSAGE_MAX];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    if (log_callback) {
+        log_callback(level, message, log_callback_user_data);
+    } else {
+        // One write per message, so concurrent messages don't interleave
+        fprintf(stderr, "Podi [%s]: %s\n", podi_log_level_name(level), message);
+    }
+}
@@ -2,6 +2,7 @@
 #include "internal.h"
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 @interface PodiApplicationDelegate : NSObject <NSApplicationDelegate>
 @end
@@ -26,9 +27,18 @@ typedef struct {
     podi_application_cocoa *app;
     PodiWindow *window;
     PodiView *view;
-    NSMutableArray *eventQueue;
 } podi_window_cocoa;
 
+// NSEvent timestamps count seconds since boot, excluding sleep, which is
+// the CLOCK_UPTIME_RAW timeline; events without one use the current time
+static uint64_t cocoa_time_now_ns(void) {
+    return clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+}
+
+static uint64_t cocoa_event_time_ns(NSEvent *event) {
+    return (uint64_t)([event timestamp] * 1e9);
+}
+
 static podi_key cocoa_keycode_to_podi_key(unsigned short keyCode) {
     switch (keyCode) {
         case 0x00: return PODI_KEY_A;
@@ -101,10 +111,11 @@ static podi_key cocoa_keycode_to_podi_key(unsigned short keyCode) {
 - (void)windowWillClose:(NSNotification *)notification {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *event = malloc(sizeof(podi_event));
-        event->type = PODI_EVENT_WINDOW_CLOSE;
-        event->window = (podi_window *)window;
-        [window->eventQueue addObject:[NSValue valueWithPointer:event]];
+        podi_event event = {0};
+        event.type = PODI_EVENT_WINDOW_CLOSE;
+        event.window = (podi_window *)window;
+        event.timestamp_ns = cocoa_time_now_ns();
+        podi_application_push_event(&window->app->common, &event);
     }
 }
 
@@ -115,32 +126,35 @@ static podi_key cocoa_keycode_to_podi_key(unsigned short keyCode) {
         window->common.width = (int)frame.size.width;
         window->common.height = (int)frame.size.height;
         
-        podi_event *event = malloc(sizeof(podi_event));
-        event->type = PODI_EVENT_WINDOW_RESIZE;
-        event->window = (podi_window *)window;
-        event->window_resize.width = (int)frame.size.width;
-        event->window_resize.height = (int)frame.size.height;
-        [window->eventQueue addObject:[NSValue valueWithPointer:event]];
+        podi_event event = {0};
+        event.type = PODI_EVENT_WINDOW_RESIZE;
+        event.window = (podi_window *)window;
+        event.timestamp_ns = cocoa_time_now_ns();
+        event.window_resize.width = (int)frame.size.width;
+        event.window_resize.height = (int)frame.size.height;
+        podi_application_push_event(&window->app->common, &event);
     }
 }
 
 - (void)windowDidBecomeKey:(NSNotification *)notification {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *event = malloc(sizeof(podi_event));
-        event->type = PODI_EVENT_WINDOW_FOCUS;
-        event->window = (podi_window *)window;
-        [window->eventQueue addObject:[NSValue valueWithPointer:event]];
+        podi_event event = {0};
+        event.type = PODI_EVENT_WINDOW_FOCUS;
+        event.window = (podi_window *)window;
+        event.timestamp_ns = cocoa_time_now_ns();
+        podi_application_push_event(&window->app->common, &event);
     }
 }
 
 - (void)windowDidResignKey:(NSNotification *)notification {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *event = malloc(sizeof(podi_event));
-        event->type = PODI_EVENT_WINDOW_UNFOCUS;
-        event->window = (podi_window *)window;
-        [window->eventQueue addObject:[NSValue valueWithPointer:event]];
+        podi_event event = {0};
+        event.type = PODI_EVENT_WINDOW_UNFOCUS;
+        event.window = (podi_window *)window;
+        event.timestamp_ns = cocoa_time_now_ns();
+        podi_application_push_event(&window->app->common, &event);
     }
 }
 
@@ -155,108 +169,113 @@ static podi_key cocoa_keycode_to_podi_key(unsigned short keyCode) {
 - (void)keyDown:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_KEY_DOWN;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->key.key = cocoa_keycode_to_podi_key([event keyCode]);
-        podiEvent->key.native_keycode = [event keyCode];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_KEY_DOWN;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.key.key = cocoa_keycode_to_podi_key([event keyCode]);
+        podiEvent.key.native_keycode = [event keyCode];
+        podiEvent.key.is_repeat = [event isARepeat];
         
-        // Get text input from the event
+        podi_application_push_event(&window->app->common, &podiEvent);
+
+        // Text follows the key as its own event with inline storage
         NSString *characters = [event characters];
-        if (characters && [characters length] > 0) {
-            // Store the text in a static buffer (similar to X11 approach)
-            static char text_buffer[32];
-            const char *utf8String = [characters UTF8String];
-            if (utf8String && strlen(utf8String) < sizeof(text_buffer)) {
-                strcpy(text_buffer, utf8String);
-                podiEvent->key.text = text_buffer;
-            } else {
-                podiEvent->key.text = NULL;
-            }
-        } else {
-            podiEvent->key.text = NULL;
+        // Function and arrow keys report private-use characters, not text
+        bool isFunctionKey = characters && [characters length] > 0 &&
+                             [characters characterAtIndex:0] >= 0xF700 && [characters characterAtIndex:0] <= 0xF8FF;
+        const char *utf8String = (characters && !isFunctionKey) ? [characters UTF8String] : NULL;
+        podi_event textEvent;
+        if (utf8String && podi_event_init_text_input(&textEvent, (podi_window *)window, utf8String, strlen(utf8String))) {
+            textEvent.timestamp_ns = podiEvent.timestamp_ns;
+            podi_application_push_event(&window->app->common, &textEvent);
         }
-        
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
     }
 }
 
 - (void)keyUp:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_KEY_UP;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->key.key = cocoa_keycode_to_podi_key([event keyCode]);
-        podiEvent->key.native_keycode = [event keyCode];
-        podiEvent->key.text = NULL; // No text on key release
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_KEY_UP;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.key.key = cocoa_keycode_to_podi_key([event keyCode]);
+        podiEvent.key.native_keycode = [event keyCode];
+        podiEvent.key.is_repeat = false;
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
 - (void)mouseDown:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_MOUSE_BUTTON_DOWN;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->mouse_button.button = PODI_MOUSE_BUTTON_LEFT;
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_MOUSE_BUTTON_DOWN;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.mouse_button.button = PODI_MOUSE_BUTTON_LEFT;
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
 - (void)mouseUp:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_MOUSE_BUTTON_UP;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->mouse_button.button = PODI_MOUSE_BUTTON_LEFT;
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_MOUSE_BUTTON_UP;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.mouse_button.button = PODI_MOUSE_BUTTON_LEFT;
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
 - (void)rightMouseDown:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_MOUSE_BUTTON_DOWN;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->mouse_button.button = PODI_MOUSE_BUTTON_RIGHT;
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_MOUSE_BUTTON_DOWN;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.mouse_button.button = PODI_MOUSE_BUTTON_RIGHT;
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
 - (void)rightMouseUp:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_MOUSE_BUTTON_UP;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->mouse_button.button = PODI_MOUSE_BUTTON_RIGHT;
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_MOUSE_BUTTON_UP;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.mouse_button.button = PODI_MOUSE_BUTTON_RIGHT;
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
 - (void)otherMouseDown:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_MOUSE_BUTTON_DOWN;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->mouse_button.button = PODI_MOUSE_BUTTON_MIDDLE;
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_MOUSE_BUTTON_DOWN;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.mouse_button.button = PODI_MOUSE_BUTTON_MIDDLE;
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
 - (void)otherMouseUp:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_MOUSE_BUTTON_UP;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->mouse_button.button = PODI_MOUSE_BUTTON_MIDDLE;
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_MOUSE_BUTTON_UP;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.mouse_button.button = PODI_MOUSE_BUTTON_MIDDLE;
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
@@ -264,12 +283,13 @@ static podi_key cocoa_keycode_to_podi_key(unsigned short keyCode) {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
         NSPoint point = [self convertPoint:[event locationInWindow] fromView:nil];
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_MOUSE_MOVE;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->mouse_move.x = point.x;
-        podiEvent->mouse_move.y = window->common.height - point.y;
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_MOUSE_MOVE;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.mouse_move.x = point.x;
+        podiEvent.mouse_move.y = window->common.height - point.y;
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
@@ -288,12 +308,13 @@ static podi_key cocoa_keycode_to_podi_key(unsigned short keyCode) {
 - (void)scrollWheel:(NSEvent *)event {
     podi_window_cocoa *window = (podi_window_cocoa *)self.podiWindow;
     if (window) {
-        podi_event *podiEvent = malloc(sizeof(podi_event));
-        podiEvent->type = PODI_EVENT_MOUSE_SCROLL;
-        podiEvent->window = (podi_window *)window;
-        podiEvent->mouse_scroll.x = [event scrollingDeltaX];
-        podiEvent->mouse_scroll.y = [event scrollingDeltaY];
-        [window->eventQueue addObject:[NSValue valueWithPointer:podiEvent]];
+        podi_event podiEvent = {0};
+        podiEvent.type = PODI_EVENT_MOUSE_SCROLL;
+        podiEvent.window = (podi_window *)window;
+        podiEvent.timestamp_ns = cocoa_event_time_ns(event);
+        podiEvent.mouse_scroll.x = [event scrollingDeltaX];
+        podiEvent.mouse_scroll.y = [event scrollingDeltaY];
+        podi_application_push_event(&window->app->common, &podiEvent);
     }
 }
 
@@ -322,6 +343,7 @@ static void cocoa_application_destroy(podi_application *app_generic) {
         }
     }
     free(app->common.windows);
+    podi_event_queue_free(&app->common.events);
     
     [app->delegate release];
     [app->pool release];
@@ -342,29 +364,21 @@ static bool cocoa_application_poll_event(podi_application *app_generic, podi_eve
     podi_application_cocoa *app = (podi_application_cocoa *)app_generic;
     if (!app || !event) return false;
     
+    // Handlers deliver through podi_application_push_event, which applies
+    // masks, the callback and per-window queues, so an NSEvent may leave
+    // nothing in the application queue; keep pumping until one does
     @autoreleasepool {
-        NSEvent *nsEvent = [app->app nextEventMatchingMask:NSEventMaskAny
-                                                 untilDate:[NSDate distantPast]
-                                                    inMode:NSDefaultRunLoopMode
-                                                   dequeue:YES];
-        if (nsEvent) {
+        while (app->common.events.count == 0) {
+            NSEvent *nsEvent = [app->app nextEventMatchingMask:NSEventMaskAny
+                                                     untilDate:[NSDate distantPast]
+                                                        inMode:NSDefaultRunLoopMode
+                                                       dequeue:YES];
+            if (!nsEvent) break;
             [app->app sendEvent:nsEvent];
         }
-        
-        for (size_t i = 0; i < app->common.window_count; i++) {
-            podi_window_cocoa *window = (podi_window_cocoa *)app->common.windows[i];
-            if (window && [window->eventQueue count] > 0) {
-                NSValue *value = [window->eventQueue objectAtIndex:0];
-                podi_event *queued_event = [value pointerValue];
-                *event = *queued_event;
-                free(queued_event);
-                [window->eventQueue removeObjectAtIndex:0];
-                return true;
-            }
-        }
     }
-    
-    return false;
+
+    return podi_event_queue_pop(&app->common.events, event);
 }
 
 static podi_window *cocoa_window_create(podi_application *app_generic, const char *title, int width, int height) {
@@ -378,7 +392,6 @@ static podi_window *cocoa_window_create(podi_application *app_generic, const cha
     window->common.width = width;
     window->common.height = height;
     window->common.title = strdup(title ? title : "Podi Window");
-    window->eventQueue = [[NSMutableArray alloc] init];
     
     @autoreleasepool {
         NSRect frame = NSMakeRect(100, 100, width, height);
@@ -407,7 +420,6 @@ static podi_window *cocoa_window_create(podi_application *app_generic, const cha
         podi_window **new_windows = realloc(app->common.windows, new_capacity * sizeof(podi_window *));
         if (!new_windows) {
             [window->window close];
-            [window->eventQueue release];
             free(window->common.title);
             free(window);
             return NULL;
@@ -416,6 +428,7 @@ static podi_window *cocoa_window_create(podi_application *app_generic, const cha
         app->common.window_capacity = new_capacity;
     }
     
+    window->common.id = app->common.next_window_id++;
     app->common.windows[app->common.window_count++] = (podi_window *)window;
     
     return (podi_window *)window;
@@ -438,7 +451,6 @@ static void cocoa_window_destroy(podi_window *window_generic) {
     
     @autoreleasepool {
         [window->window close];
-        [window->eventQueue release];
     }
     
     free(window->common.title);
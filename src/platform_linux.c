@@ -1,8 +1,16 @@
+#define _GNU_SOURCE
 #include "internal.h"
 #include "podi.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 
 #ifdef PODI_BACKEND_BOTH
 #include <X11/Xlib.h>
@@ -16,6 +24,8 @@ extern const podi_platform_vtable x11_vtable;
 #ifndef PODI_BACKEND_X11_ONLY
 extern const podi_platform_vtable wayland_vtable;
 #endif
+extern const podi_platform_vtable replay_vtable;
+extern const podi_platform_vtable headless_vtable;
 
 static podi_backend_type selected_backend = PODI_BACKEND_AUTO;
 const podi_platform_vtable *podi_platform = NULL;
@@ -48,6 +58,12 @@ podi_backend_type podi_get_backend(void) {
         return PODI_BACKEND_WAYLAND;
     }
 #endif
+    if (podi_platform == &replay_vtable) {
+        return PODI_BACKEND_REPLAY;
+    }
+    if (podi_platform == &headless_vtable) {
+        return PODI_BACKEND_HEADLESS;
+    }
     return selected_backend;
 }
 
@@ -56,6 +72,8 @@ const char *podi_get_backend_name(void) {
     switch (backend) {
         case PODI_BACKEND_X11: return "X11";
         case PODI_BACKEND_WAYLAND: return "Wayland";
+        case PODI_BACKEND_REPLAY: return "Replay";
+        case PODI_BACKEND_HEADLESS: return "Headless";
         case PODI_BACKEND_AUTO: return "Auto";
         default: return "Unknown";
     }
@@ -64,8 +82,7 @@ const char *podi_get_backend_name(void) {
 void podi_init_platform(void) {
     if (podi_platform) return;
 
-    fprintf(stderr, "Podi: Initializing platform...\n");
-    fflush(stderr);
+    PODI_LOG_INFO("Initializing platform...");
     
     // Check environment variable for backend override
     const char *env_backend = getenv("PODI_BACKEND");
@@ -74,6 +91,10 @@ void podi_init_platform(void) {
             selected_backend = PODI_BACKEND_X11;
         } else if (strcmp(env_backend, "wayland") == 0 || strcmp(env_backend, "WAYLAND") == 0) {
             selected_backend = PODI_BACKEND_WAYLAND;
+        } else if (strcmp(env_backend, "replay") == 0 || strcmp(env_backend, "REPLAY") == 0) {
+            selected_backend = PODI_BACKEND_REPLAY;
+        } else if (strcmp(env_backend, "headless") == 0 || strcmp(env_backend, "HEADLESS") == 0) {
+            selected_backend = PODI_BACKEND_HEADLESS;
         }
     }
     
@@ -89,24 +110,29 @@ void podi_init_platform(void) {
             podi_platform = &wayland_vtable;
 #endif
             break;
+
+        case PODI_BACKEND_REPLAY:
+            podi_platform = &replay_vtable;
+            break;
+
+        case PODI_BACKEND_HEADLESS:
+            podi_platform = &headless_vtable;
+            break;
             
         case PODI_BACKEND_AUTO:
         default:
 #ifndef PODI_BACKEND_X11_ONLY
             if (wayland_available()) {
-                fprintf(stderr, "Podi: Selected Wayland backend\n");
-                fflush(stderr);
+                PODI_LOG_INFO("Selected Wayland backend");
                 podi_platform = &wayland_vtable;
             } else
 #endif
 #ifndef PODI_BACKEND_WAYLAND_ONLY
             if (x11_available()) {
-                printf("Podi: Selected X11 backend\n");
-                fflush(stdout);
+                PODI_LOG_INFO("Selected X11 backend");
                 podi_platform = &x11_vtable;
             } else {
-                printf("Podi: Fallback to X11 backend\n");
-                fflush(stdout);
+                PODI_LOG_INFO("Fallback to X11 backend");
                 podi_platform = &x11_vtable;
             }
 #endif
@@ -122,4 +148,191 @@ void podi_init_platform(void) {
 }
 
 void podi_cleanup_platform(void) {
-}
\ No newline at end of file
+}
+
+uint64_t podi_time_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// Server time moving back by more than this, or ahead of local time by
+// more than this, is a clock jump (e.g. a new compositor) rather than
+// events arriving out of order; the estimate is started over
+#define PODI_CLOCK_SYNC_JUMP_NS (1LL * 1000000000LL)
+
+// Folds one sample into the offset estimate and returns server_ns on the
+// monotonic clock
+static uint64_t podi_clock_sync_sample(podi_clock_sync *sync, int64_t server_ns) {
+    uint64_t now = podi_time_now_ns();
+    int64_t sample = (int64_t)now - server_ns;
+
+    // A long receive delay alone (the client didn't poll for a while) is
+    // not a jump: server time still advanced no faster than local time
+    bool jumped = false;
+    if (sync->valid) {
+        int64_t server_elapsed = server_ns - sync->last_server_ns;
+        int64_t local_elapsed = (int64_t)(now - sync->last_local_ns);
+        jumped = server_elapsed < -PODI_CLOCK_SYNC_JUMP_NS ||
+                 server_elapsed > local_elapsed + PODI_CLOCK_SYNC_JUMP_NS;
+    }
+    sync->last_server_ns = server_ns;
+    sync->last_local_ns = now;
+
+    // Every event is received after it happened, so the smallest delay seen
+    // is the tightest estimate of the offset
+    if (!sync->valid || jumped || sample < sync->offset_ns) {
+        sync->offset_ns = sample;
+        sync->valid = true;
+    }
+
+    int64_t converted = server_ns + sync->offset_ns;
+    return converted > 0 ? (uint64_t)converted : 0;
+}
+
+uint64_t podi_clock_sync_convert(podi_clock_sync *sync, uint32_t server_ms) {
+    // Treat a large backwards step as the 32-bit counter wrapping; small
+    // ones are just events that were generated out of order
+    if (sync->valid && server_ms < sync->last_ms && sync->last_ms - server_ms > 0x80000000u) {
+        sync->epoch_ms += 0x100000000ULL;
+    }
+    sync->last_ms = server_ms;
+
+    return podi_clock_sync_sample(sync, (int64_t)((sync->epoch_ms + server_ms) * 1000000ULL));
+}
+
+uint64_t podi_clock_sync_convert_us(podi_clock_sync *sync, uint64_t server_us) {
+    return podi_clock_sync_sample(sync, (int64_t)(server_us * 1000ULL));
+}
+
+int podi_poll(struct pollfd *fds, size_t count, int64_t timeout_ns) {
+    uint64_t deadline = timeout_ns > 0 ? podi_time_now_ns() + (uint64_t)timeout_ns : 0;
+
+    while (true) {
+        int timeout_ms = -1;
+        if (timeout_ns == 0) {
+            timeout_ms = 0;
+        } else if (timeout_ns > 0) {
+            uint64_t now = podi_time_now_ns();
+            uint64_t remaining = deadline > now ? deadline - now : 0;
+            // Round up so short timeouts still sleep instead of spinning
+            uint64_t remaining_ms = (remaining + 999999ULL) / 1000000ULL;
+            timeout_ms = remaining_ms > (uint64_t)INT_MAX ? INT_MAX : (int)remaining_ms;
+        }
+
+        int result = poll(fds, (nfds_t)count, timeout_ms);
+        if (result >= 0 || errno != EINTR) {
+            return result;
+        }
+    }
+}
+
+int podi_epoll_create(const int *fds, size_t count) {
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) return -1;
+
+    for (size_t i = 0; i < count; i++) {
+        struct epoll_event event = { .events = EPOLLIN, .data.fd = fds[i] };
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fds[i], &event) < 0) {
+            close(epoll_fd);
+            return -1;
+        }
+    }
+    return epoll_fd;
+}
+
+bool podi_wakeup_init(podi_wakeup *wakeup) {
+    wakeup->fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeup->fd < 0) return false;
+
+    atomic_init(&wakeup->pending, false);
+    pthread_mutex_init(&wakeup->lock, NULL);
+    wakeup->payloads = NULL;
+    wakeup->count = 0;
+    wakeup->capacity = 0;
+    return true;
+}
+
+void podi_wakeup_destroy(podi_wakeup *wakeup) {
+    if (wakeup->fd < 0) return;
+
+    close(wakeup->fd);
+    wakeup->fd = -1;
+    pthread_mutex_destroy(&wakeup->lock);
+    free(wakeup->payloads);
+    wakeup->payloads = NULL;
+    wakeup->count = 0;
+    wakeup->capacity = 0;
+}
+
+bool podi_wakeup_post(podi_wakeup *wakeup, void *payload) {
+    if (wakeup->fd < 0) return false;
+
+    pthread_mutex_lock(&wakeup->lock);
+    if (wakeup->count >= wakeup->capacity) {
+        size_t new_capacity = wakeup->capacity ? wakeup->capacity * 2 : 16;
+        void **new_payloads = realloc(wakeup->payloads, new_capacity * sizeof(void *));
+        if (!new_payloads) {
+            pthread_mutex_unlock(&wakeup->lock);
+            return false;
+        }
+        wakeup->payloads = new_payloads;
+        wakeup->capacity = new_capacity;
+    }
+    wakeup->payloads[wakeup->count++] = payload;
+    atomic_store_explicit(&wakeup->pending, true, memory_order_release);
+    pthread_mutex_unlock(&wakeup->lock);
+
+    // A full counter (EAGAIN) still leaves the fd readable, which is all we need
+    uint64_t one = 1;
+    ssize_t written = write(wakeup->fd, &one, sizeof(one));
+    (void)written;
+    return true;
+}
+
+void podi_wakeup_acknowledge(podi_wakeup *wakeup) {
+    if (wakeup->fd < 0) return;
+
+    uint64_t value;
+    ssize_t result = read(wakeup->fd, &value, sizeof(value));
+    (void)result;
+}
+
+// Payloads are moved out in batches so the lock is not held while the
+// event callback runs; it may post another wakeup
+#define PODI_WAKEUP_DRAIN_BATCH 32
+
+void podi_wakeup_drain(podi_wakeup *wakeup, podi_application_common *app) {
+    if (!atomic_load_explicit(&wakeup->pending, memory_order_acquire)) return;
+
+    uint64_t now = podi_time_now_ns();
+
+    while (true) {
+        void *batch[PODI_WAKEUP_DRAIN_BATCH];
+        size_t count = 0;
+
+        // Without a callback the wakeups land in the application queue;
+        // payloads that would not fit stay posted, in order, for a later drain
+        pthread_mutex_lock(&wakeup->lock);
+        while (count < wakeup->count && count < PODI_WAKEUP_DRAIN_BATCH &&
+               (app->event_callback || !podi_event_queue_is_full(&app->events, count))) {
+            batch[count] = wakeup->payloads[count];
+            count++;
+        }
+        wakeup->count -= count;
+        memmove(wakeup->payloads, wakeup->payloads + count, wakeup->count * sizeof(void *));
+        bool more = wakeup->count > 0;
+        atomic_store_explicit(&wakeup->pending, more, memory_order_relaxed);
+        pthread_mutex_unlock(&wakeup->lock);
+
+        for (size_t i = 0; i < count; i++) {
+            podi_event event = {0};
+            event.type = PODI_EVENT_WAKEUP;
+            event.timestamp_ns = now;
+            event.wakeup.payload = batch[i];
+            podi_application_push_event(app, &event);
+        }
+
+        if (!more || count < PODI_WAKEUP_DRAIN_BATCH) return;
+    }
+}
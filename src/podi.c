@@ -7,8 +7,11 @@
 static bool podi_initialized = false;
 
 static void ensure_initialized(void) {
-    if (!podi_initialized) {
+    // podi_set_backend() clears the platform, so select again after a switch
+    if (!podi_platform) {
         podi_init_platform();
+    }
+    if (!podi_initialized) {
         podi_initialized = true;
         atexit(podi_cleanup_platform);
     }
@@ -16,11 +19,16 @@ static void ensure_initialized(void) {
 
 podi_application *podi_application_create(void) {
     ensure_initialized();
+    PODI_TRACE_SCOPE(__func__);
     return podi_platform->application_create();
 }
 
 void podi_application_destroy(podi_application *app) {
     if (!app) return;
+    PODI_TRACE_SCOPE(__func__);
+#ifdef PODI_PLATFORM_LINUX
+    podi_application_stop_recording(app);
+#endif
     podi_platform->application_destroy(app);
 }
 
@@ -36,9 +44,142 @@ void podi_application_close(podi_application *app) {
 
 bool podi_application_poll_event(podi_application *app, podi_event *event) {
     if (!app || !event) return false;
+    PODI_TRACE_SCOPE(__func__);
     return podi_platform->application_poll_event(app, event);
 }
 
+size_t podi_application_poll_events(podi_application *app, podi_event *events, size_t capacity) {
+    if (!app || !events || capacity == 0) return 0;
+    PODI_TRACE_SCOPE(__func__);
+    if (podi_platform->application_poll_events) {
+        return podi_platform->application_poll_events(app, events, capacity);
+    }
+
+    size_t count = 0;
+    while (count < capacity && podi_platform->application_poll_event(app, &events[count])) {
+        count++;
+    }
+    return count;
+}
+
+bool podi_application_wait_events(podi_application *app, int64_t timeout_ns) {
+    if (!app) return false;
+    PODI_TRACE_SCOPE(__func__);
+    if (!podi_platform->application_wait_events) return true;
+    return podi_platform->application_wait_events(app, timeout_ns);
+}
+
+bool podi_application_post_wakeup(podi_application *app, void *payload) {
+    if (!app) return false;
+#ifdef PODI_PLATFORM_LINUX
+    podi_application_common *common = (podi_application_common *)app;
+    return podi_wakeup_post(&common->wakeup, payload);
+#else
+    (void)payload;
+    return false;
+#endif
+}
+
+int podi_application_get_fd(podi_application *app) {
+    if (!app) return -1;
+    if (!podi_platform->application_get_fd) return -1;
+    return podi_platform->application_get_fd(app);
+}
+
+bool podi_application_prepare_read(podi_application *app) {
+    if (!app) return false;
+    PODI_TRACE_SCOPE(__func__);
+    if (!podi_platform->application_prepare_read) return false;
+    return podi_platform->application_prepare_read(app);
+}
+
+bool podi_application_dispatch_events(podi_application *app, bool fd_readable) {
+    if (!app) return false;
+    PODI_TRACE_SCOPE(__func__);
+    if (!podi_platform->application_dispatch_events) return true;
+    return podi_platform->application_dispatch_events(app, fd_readable);
+}
+
+void podi_application_flush(podi_application *app) {
+    if (!app) return;
+    PODI_TRACE_SCOPE(__func__);
+    if (!podi_platform->application_flush) return;
+    podi_platform->application_flush(app);
+}
+
+void podi_application_set_deferred_flush(podi_application *app, bool deferred) {
+    if (!app) return;
+    podi_application_common *common = (podi_application_common *)app;
+    common->flush_deferred = deferred;
+    if (!deferred) podi_application_flush(app);
+}
+
+void podi_application_set_event_callback(podi_application *app, podi_event_callback callback, void *user_data) {
+    if (!app) return;
+    podi_application_common *common = (podi_application_common *)app;
+    common->event_callback = callback;
+    common->event_callback_user_data = user_data;
+}
+
+size_t podi_application_dispatch(podi_application *app) {
+    if (!app) return 0;
+    podi_application_common *common = (podi_application_common *)app;
+    if (!common->event_callback) return 0;
+    PODI_TRACE_SCOPE(__func__);
+
+    size_t start = common->event_callback_count;
+
+    // Events queued before the callback was set are the oldest, so they go first
+    podi_event event;
+    while (common->event_callback && podi_event_queue_pop(&common->events, &event)) {
+        common->event_callback_count++;
+        common->event_callback(app, &event, common->event_callback_user_data);
+    }
+
+    if (podi_platform->application_dispatch_events) {
+        podi_platform->application_dispatch_events(app, true);
+    } else {
+        // Polled events have already been counted, recorded and filtered
+        // by podi_application_push_event, so they go straight out
+        while (common->event_callback && podi_platform->application_poll_event(app, &event)) {
+            common->event_callback_count++;
+            common->event_callback(app, &event, common->event_callback_user_data);
+        }
+    }
+
+#ifdef PODI_PLATFORM_LINUX
+    // Cross-thread wakeups go to the callback through the common push path
+    podi_wakeup_drain(&common->wakeup, common);
+#endif
+
+    return common->event_callback_count - start;
+}
+
+void podi_application_set_event_queue_capacity(podi_application *app, size_t capacity) {
+    if (!app) return;
+    podi_application_common *common = (podi_application_common *)app;
+    common->events.limit = capacity;
+}
+
+uint64_t podi_application_get_dropped_event_count(podi_application *app) {
+    if (!app) return 0;
+    podi_application_common *common = (podi_application_common *)app;
+    return common->events.dropped;
+}
+
+bool podi_application_get_stats(podi_application *app, podi_application_stats *stats) {
+    if (!stats) return false;
+    memset(stats, 0, sizeof(*stats));
+    if (!app) return false;
+#ifndef PODI_NO_STATS
+    podi_application_common *common = (podi_application_common *)app;
+    *stats = common->stats;
+    return true;
+#else
+    return false;
+#endif
+}
+
 float podi_get_display_scale_factor(podi_application *app) {
     if (!app) return 1.0f;
     return podi_platform->get_display_scale_factor(app);
@@ -46,11 +187,21 @@ float podi_get_display_scale_factor(podi_application *app) {
 
 podi_window *podi_window_create(podi_application *app, const char *title, int width, int height) {
     if (!app) return NULL;
+    PODI_TRACE_SCOPE(__func__);
     return podi_platform->window_create(app, title, width, height);
 }
 
 void podi_window_destroy(podi_window *window) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
+
+    podi_window_common *common = (podi_window_common *)window;
+    podi_window_set_event_queue_enabled(window, false);
+    if (common->events_lock_initialized) {
+        pthread_mutex_destroy(&common->events_lock);
+        common->events_lock_initialized = false;
+    }
+
     podi_platform->window_destroy(window);
 }
 
@@ -61,16 +212,19 @@ void podi_window_close(podi_window *window) {
 
 void podi_window_set_title(podi_window *window, const char *title) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
     podi_platform->window_set_title(window, title);
 }
 
 void podi_window_set_size(podi_window *window, int width, int height) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
     podi_platform->window_set_size(window, width, height);
 }
 
 void podi_window_set_position_and_size(podi_window *window, int x, int y, int width, int height) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
     podi_platform->window_set_position_and_size(window, x, y, width, height);
 }
 
@@ -101,31 +255,37 @@ bool podi_window_should_close(podi_window *window) {
 
 void podi_window_begin_interactive_resize(podi_window *window, int edge) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
     podi_platform->window_begin_interactive_resize(window, edge);
 }
 
 void podi_window_begin_move(podi_window *window) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
     podi_platform->window_begin_move(window);
 }
 
 void podi_window_set_cursor(podi_window *window, podi_cursor_shape cursor) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
     podi_platform->window_set_cursor(window, cursor);
 }
 
 void podi_window_set_cursor_mode(podi_window *window, bool locked, bool visible) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
     podi_platform->window_set_cursor_mode(window, locked, visible);
 }
 
 void podi_window_get_cursor_position(podi_window *window, double *x, double *y) {
     if (!window || !x || !y) return;
+    PODI_TRACE_SCOPE(__func__);
     podi_platform->window_get_cursor_position(window, x, y);
 }
 
 void podi_window_set_fullscreen_exclusive(podi_window *window, bool enabled) {
     if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
     if (!podi_platform->window_set_fullscreen_exclusive) return;
     podi_platform->window_set_fullscreen_exclusive(window, enabled);
 }
@@ -136,6 +296,201 @@ bool podi_window_is_fullscreen_exclusive(podi_window *window) {
     return podi_platform->window_is_fullscreen_exclusive(window);
 }
 
+void podi_window_set_motion_coalescing(podi_window *window, bool enabled) {
+    if (!window) return;
+    podi_window_common *common = (podi_window_common *)window;
+    common->coalesce_motion = enabled;
+}
+
+void podi_window_set_raw_motion(podi_window *window, bool enabled) {
+    if (!window) return;
+    podi_window_common *common = (podi_window_common *)window;
+    common->raw_motion = enabled;
+}
+
+void podi_window_set_event_queue_enabled(podi_window *window, bool enabled) {
+    if (!window) return;
+    podi_window_common *common = (podi_window_common *)window;
+
+    if (enabled && !common->events_lock_initialized) {
+        pthread_mutex_init(&common->events_lock, NULL);
+        common->events_lock_initialized = true;
+    }
+    if (!common->events_lock_initialized) return;
+
+    pthread_mutex_lock(&common->events_lock);
+    common->has_event_queue = enabled;
+    if (!enabled) {
+        podi_event_queue_free(&common->events);
+    }
+    pthread_mutex_unlock(&common->events_lock);
+}
+
+bool podi_window_poll_event(podi_window *window, podi_event *event) {
+    if (!window || !event) return false;
+    podi_window_common *common = (podi_window_common *)window;
+    if (!common->events_lock_initialized) return false;
+
+    pthread_mutex_lock(&common->events_lock);
+    bool result = podi_event_queue_pop(&common->events, event);
+    pthread_mutex_unlock(&common->events_lock);
+    return result;
+}
+
+size_t podi_window_poll_events(podi_window *window, podi_event *events, size_t capacity) {
+    if (!window || !events || capacity == 0) return 0;
+    podi_window_common *common = (podi_window_common *)window;
+    if (!common->events_lock_initialized) return 0;
+
+    pthread_mutex_lock(&common->events_lock);
+    size_t count = podi_event_queue_pop_many(&common->events, events, capacity);
+    pthread_mutex_unlock(&common->events_lock);
+    return count;
+}
+
+void podi_window_set_event_mask(podi_window *window, uint32_t mask) {
+    if (!window) return;
+    PODI_TRACE_SCOPE(__func__);
+    podi_window_common *common = (podi_window_common *)window;
+    common->ignored_events = ~mask;
+    if (podi_platform->window_set_event_mask) {
+        podi_platform->window_set_event_mask(window);
+    }
+}
+
+bool podi_window_accepts_event(podi_window *window, podi_event_type type) {
+    if (!window) return true;
+    return !(((podi_window_common *)window)->ignored_events & PODI_EVENT_MASK(type));
+}
+
+bool podi_event_init_text_input(podi_event *event, podi_window *window, const char *text, size_t length) {
+    if (!text || length == 0) return false;
+    unsigned char first = (unsigned char)text[0];
+    if (first < 0x20 || first == 0x7f) return false;
+
+    // Back off to the start of a UTF-8 sequence so no character is cut in half
+    size_t capacity = sizeof(event->text_input.text) - 1;
+    if (length > capacity) {
+        length = capacity;
+        while (length > 0 && ((unsigned char)text[length] & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+
+    memset(event, 0, sizeof(*event));
+    event->type = PODI_EVENT_TEXT_INPUT;
+    event->window = window;
+    memcpy(event->text_input.text, text, length);
+    event->text_input.text[length] = '\0';
+    return true;
+}
+
+static uint32_t podi_modifier_for_key(podi_key key) {
+    switch (key) {
+        case PODI_KEY_SHIFT: return PODI_MOD_SHIFT;
+        case PODI_KEY_CTRL: return PODI_MOD_CTRL;
+        case PODI_KEY_ALT: return PODI_MOD_ALT;
+        default: return 0;
+    }
+}
+
+void podi_window_update_input_state(podi_window_common *window, const podi_event *event) {
+    if (!window) return;
+
+    switch (event->type) {
+        case PODI_EVENT_KEY_DOWN:
+        case PODI_EVENT_KEY_UP:
+        case PODI_EVENT_MOUSE_BUTTON_DOWN:
+        case PODI_EVENT_MOUSE_BUTTON_UP:
+        case PODI_EVENT_MOUSE_MOVE:
+        case PODI_EVENT_WINDOW_UNFOCUS:
+            break;
+        default:
+            return;
+    }
+
+    // Seqlock write side: readers retry while the counter is odd or changed
+    unsigned sequence = atomic_load_explicit(&window->input_sequence, memory_order_relaxed);
+    atomic_store_explicit(&window->input_sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    podi_input_state *state = &window->input_state;
+    switch (event->type) {
+        case PODI_EVENT_KEY_DOWN:
+        case PODI_EVENT_KEY_UP: {
+            bool down = event->type == PODI_EVENT_KEY_DOWN;
+            podi_key key = event->key.key;
+            if (key > PODI_KEY_UNKNOWN && key < PODI_KEY_COUNT) {
+                uint64_t bit = 1ULL << (key % 64);
+                if (down) {
+                    state->keys_down[key / 64] |= bit;
+                } else {
+                    state->keys_down[key / 64] &= ~bit;
+                }
+            }
+
+            // Backends report modifiers from before the key changed them
+            uint32_t modifier = podi_modifier_for_key(key);
+            state->modifiers = down ? (event->key.modifiers | modifier)
+                                    : (event->key.modifiers & ~modifier);
+            break;
+        }
+        case PODI_EVENT_MOUSE_BUTTON_DOWN:
+            state->mouse_buttons |= 1u << event->mouse_button.button;
+            break;
+        case PODI_EVENT_MOUSE_BUTTON_UP:
+            state->mouse_buttons &= ~(1u << event->mouse_button.button);
+            break;
+        case PODI_EVENT_MOUSE_MOVE:
+            state->mouse_x = event->mouse_move.x;
+            state->mouse_y = event->mouse_move.y;
+            break;
+        case PODI_EVENT_WINDOW_UNFOCUS:
+            // Releases after this go to another window, so nothing stays held
+            memset(state->keys_down, 0, sizeof(state->keys_down));
+            state->mouse_buttons = 0;
+            state->modifiers = 0;
+            break;
+        default:
+            break;
+    }
+
+    atomic_store_explicit(&window->input_sequence, sequence + 2, memory_order_release);
+}
+
+void podi_window_get_input_state(podi_window *window, podi_input_state *state) {
+    if (!state) return;
+    if (!window) {
+        memset(state, 0, sizeof(*state));
+        return;
+    }
+
+    podi_window_common *common = (podi_window_common *)window;
+    unsigned before, after;
+    do {
+        before = atomic_load_explicit(&common->input_sequence, memory_order_acquire);
+        *state = common->input_state;
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&common->input_sequence, memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+}
+
+bool podi_window_is_key_down(podi_window *window, podi_key key) {
+    if (!window || key <= PODI_KEY_UNKNOWN || key >= PODI_KEY_COUNT) return false;
+
+    podi_window_common *common = (podi_window_common *)window;
+    unsigned before, after;
+    uint64_t word;
+    do {
+        before = atomic_load_explicit(&common->input_sequence, memory_order_acquire);
+        word = common->input_state.keys_down[key / 64];
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&common->input_sequence, memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+
+    return (word >> (key % 64)) & 1u;
+}
+
 int podi_window_get_title_bar_height(podi_window *window) {
     if (!window) return 0;
     if (!podi_platform->window_get_title_bar_height) return 0;
@@ -152,6 +507,52 @@ bool podi_window_get_wayland_handles(podi_window *window, podi_wayland_handles *
     if (!window || !handles) return false;
     return podi_platform->window_get_wayland_handles(window, handles);
 }
+
+bool podi_application_start_recording(podi_application *app, const char *path) {
+    if (!app || !path) return false;
+    podi_application_stop_recording(app);
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    podi_recording_header header = {0};
+    memcpy(header.magic, PODI_RECORDING_MAGIC, sizeof(header.magic));
+    header.version = PODI_RECORDING_VERSION;
+    header.record_size = sizeof(podi_recorded_event);
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        fclose(file);
+        return false;
+    }
+
+    ((podi_application_common *)app)->recording = file;
+    return true;
+}
+
+void podi_application_stop_recording(podi_application *app) {
+    if (!app) return;
+    podi_application_common *common = (podi_application_common *)app;
+    if (!common->recording) return;
+
+    fclose(common->recording);
+    common->recording = NULL;
+}
+
+bool podi_application_inject_event(podi_application *app, const podi_event *event) {
+    if (!app || !event) return false;
+    return podi_application_push_event((podi_application_common *)app, event);
+}
+
+static void podi_application_record_event(podi_application_common *app, const podi_event *event) {
+    podi_recorded_event record = {0};
+    record.window_id = event->window ? ((podi_window_common *)event->window)->id : PODI_RECORDING_NO_WINDOW;
+    record.event = *event;
+    record.event.window = NULL;
+
+    // A failed write (disk full, ...) ends the recording instead of leaving a torn log
+    if (fwrite(&record, sizeof(record), 1, app->recording) != 1) {
+        podi_application_stop_recording((podi_application *)app);
+    }
+}
 #endif
 
 podi_key podi_translate_native_keycode(uint32_t native_keycode) {
@@ -261,6 +662,78 @@ const char *podi_get_modifiers_string(uint32_t modifiers) {
     return modifier_buffer;
 }
 
+static bool podi_event_queue_grow(podi_event_queue *queue) {
+    size_t limit = queue->limit ? queue->limit : PODI_EVENT_QUEUE_DEFAULT_LIMIT;
+    if (queue->count >= limit) return false;
+
+    size_t new_capacity = queue->capacity ? queue->capacity * 2 : PODI_EVENT_QUEUE_INITIAL_CAPACITY;
+    podi_event *new_events = malloc(new_capacity * sizeof(podi_event));
+    if (!new_events) return false;
+
+    // Unwrap the existing contents so the new buffer starts at index 0
+    size_t copied = podi_event_queue_pop_many(queue, new_events, queue->count);
+    free(queue->events);
+    queue->events = new_events;
+    queue->capacity = new_capacity;
+    queue->head = 0;
+    queue->count = copied;
+    return true;
+}
+
+bool podi_event_queue_is_full(const podi_event_queue *queue, size_t reserved) {
+    size_t limit = queue->limit ? queue->limit : PODI_EVENT_QUEUE_DEFAULT_LIMIT;
+    return queue->count + reserved >= limit;
+}
+
+bool podi_event_queue_push(podi_event_queue *queue, const podi_event *event) {
+    size_t limit = queue->limit ? queue->limit : PODI_EVENT_QUEUE_DEFAULT_LIMIT;
+    if (queue->count >= limit ||
+        (queue->count == queue->capacity && !podi_event_queue_grow(queue))) {
+        queue->dropped++;
+        return false;
+    }
+
+    queue->events[(queue->head + queue->count) & (queue->capacity - 1)] = *event;
+    queue->count++;
+    return true;
+}
+
+bool podi_event_queue_pop(podi_event_queue *queue, podi_event *event) {
+    if (queue->count == 0) return false;
+
+    *event = queue->events[queue->head];
+    queue->head = (queue->head + 1) & (queue->capacity - 1);
+    queue->count--;
+    return true;
+}
+
+size_t podi_event_queue_pop_many(podi_event_queue *queue, podi_event *events, size_t capacity) {
+    size_t count = queue->count < capacity ? queue->count : capacity;
+    if (count == 0) return 0;
+
+    size_t first = queue->capacity - queue->head;
+    if (first > count) first = count;
+    memcpy(events, &queue->events[queue->head], first * sizeof(podi_event));
+    memcpy(events + first, queue->events, (count - first) * sizeof(podi_event));
+
+    queue->head = (queue->head + count) & (queue->capacity - 1);
+    queue->count -= count;
+    return count;
+}
+
+podi_event *podi_event_queue_back(podi_event_queue *queue) {
+    if (queue->count == 0) return NULL;
+    return &queue->events[(queue->head + queue->count - 1) & (queue->capacity - 1)];
+}
+
+void podi_event_queue_free(podi_event_queue *queue) {
+    free(queue->events);
+    queue->events = NULL;
+    queue->capacity = 0;
+    queue->head = 0;
+    queue->count = 0;
+}
+
 podi_resize_edge podi_detect_resize_edge(podi_window *window, double x, double y) {
     if (!window) return PODI_RESIZE_EDGE_NONE;
 
@@ -375,3 +848,92 @@ int podi_main(podi_main_func main_func) {
     podi_application_destroy(app);
     return result;
 }
+
+static bool podi_event_queue_push_coalesced(podi_event_queue *queue, const podi_event *event) {
+    if (event->type == PODI_EVENT_MOUSE_MOVE && event->window &&
+        ((podi_window_common *)event->window)->coalesce_motion) {
+        podi_event *last = podi_event_queue_back(queue);
+        if (last && last->type == PODI_EVENT_MOUSE_MOVE && last->window == event->window) {
+            last->timestamp_ns = event->timestamp_ns;
+            last->mouse_move.x = event->mouse_move.x;
+            last->mouse_move.y = event->mouse_move.y;
+            last->mouse_move.delta_x += event->mouse_move.delta_x;
+            last->mouse_move.delta_y += event->mouse_move.delta_y;
+            return true;
+        }
+    }
+
+    return podi_event_queue_push(queue, event);
+}
+
+bool podi_application_push_event(podi_application_common *app, const podi_event *event) {
+#ifdef PODI_PLATFORM_LINUX
+    // Events without a window system timestamp are stamped on arrival
+    if (event->timestamp_ns == 0) {
+        podi_event stamped = *event;
+        stamped.timestamp_ns = podi_time_now_ns();
+        return podi_application_push_event(app, &stamped);
+    }
+
+    if (app->recording) {
+        podi_application_record_event(app, event);
+    }
+#endif
+
+    if (event->type < PODI_EVENT_TYPE_COUNT) {
+        PODI_STAT_INC(app, events[event->type]);
+    }
+
+    // State is tracked before the mask check, so masking out releases
+    // cannot leave keys or buttons stuck down
+    podi_window_common *window = (podi_window_common *)event->window;
+    podi_window_update_input_state(window, event);
+
+    if (window && (window->ignored_events & PODI_EVENT_MASK(event->type))) {
+        return true;
+    }
+
+    // Demultiplex into the window's own queue if it has one. The flag is
+    // only changed on this thread, so it can be read without the lock
+    if (window && window->has_event_queue) {
+        pthread_mutex_lock(&window->events_lock);
+        bool queued = podi_event_queue_push_coalesced(&window->events, event);
+        pthread_mutex_unlock(&window->events_lock);
+        if (!queued) {
+            PODI_STAT_INC(app, events_dropped);
+            return false;
+        }
+        app->delivered_count++;
+        return true;
+    }
+
+    if (app->event_callback) {
+        app->event_callback_count++;
+        app->delivered_count++;
+        app->event_callback((podi_application *)app, event, app->event_callback_user_data);
+        return true;
+    }
+
+    if (!podi_event_queue_push_coalesced(&app->events, event)) {
+        PODI_STAT_INC(app, events_dropped);
+        return false;
+    }
+    app->delivered_count++;
+    return true;
+}
+
+bool podi_application_has_events(podi_application_common *app, uint64_t delivered_before) {
+    if (app->events.count > 0 || app->delivered_count != delivered_before) return true;
+
+    // Window queues may be drained on other threads, so check under their locks
+    for (size_t i = 0; i < app->window_count; i++) {
+        podi_window_common *window = (podi_window_common *)app->windows[i];
+        if (!window || !window->has_event_queue) continue;
+
+        pthread_mutex_lock(&window->events_lock);
+        bool pending = window->events.count > 0;
+        pthread_mutex_unlock(&window->events_lock);
+        if (pending) return true;
+    }
+    return false;
+}
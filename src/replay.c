@@ -0,0 +1,274 @@
+#define _GNU_SOURCE
+#include "internal.h"
+#include "podi.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Events handed to the queue per poll when replaying as fast as possible,
+// so a long log does not overflow a bounded queue in one go
+#define PODI_REPLAY_BATCH 256
+
+// Replay windows are the headless backend's in-memory windows; only the
+// event source differs
+typedef struct {
+    podi_application_common common;
+
+    // Read-only mapping of the whole log file
+    void *mapping;
+    size_t mapping_size;
+    const podi_recorded_event *records;
+    size_t record_count;
+    size_t next_record;
+
+    // Playback rate relative to the recording, <= 0 replays without waiting
+    double speed;
+
+    // Monotonic time playback started and the recorded time it corresponds to
+    uint64_t start_ns;
+    uint64_t base_ns;
+} podi_application_replay;
+
+static char *replay_path = NULL;
+static double replay_speed = 1.0;
+static bool replay_speed_set = false;
+
+void podi_set_replay_source(const char *path, double speed) {
+    free(replay_path);
+    replay_path = path ? strdup(path) : NULL;
+    replay_speed = speed;
+    replay_speed_set = true;
+    podi_set_backend(PODI_BACKEND_REPLAY);
+}
+
+static void replay_application_destroy(podi_application *app_generic);
+
+static bool replay_map_log(podi_application_replay *app, const char *path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(podi_recording_header)) {
+        close(fd);
+        return false;
+    }
+
+    app->mapping_size = (size_t)info.st_size;
+    app->mapping = mmap(NULL, app->mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (app->mapping == MAP_FAILED) {
+        app->mapping = NULL;
+        return false;
+    }
+
+    const podi_recording_header *header = app->mapping;
+    if (memcmp(header->magic, PODI_RECORDING_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PODI_RECORDING_VERSION ||
+        header->record_size != sizeof(podi_recorded_event)) {
+        return false;
+    }
+
+    app->records = (const podi_recorded_event *)((const char *)app->mapping + sizeof(*header));
+    app->record_count = (app->mapping_size - sizeof(*header)) / sizeof(podi_recorded_event);
+    return true;
+}
+
+static podi_application *replay_application_create(void) {
+    podi_application_replay *app = calloc(1, sizeof(podi_application_replay));
+    if (!app) return NULL;
+
+    const char *path = replay_path ? replay_path : getenv("PODI_REPLAY_FILE");
+    app->speed = replay_speed;
+    if (!replay_speed_set) {
+        const char *env_speed = getenv("PODI_REPLAY_SPEED");
+        if (env_speed) app->speed = strtod(env_speed, NULL);
+    }
+
+    if (!podi_wakeup_init(&app->common.wakeup)) {
+        free(app);
+        return NULL;
+    }
+
+    if (!path || !replay_map_log(app, path)) {
+        PODI_LOG_ERROR("Cannot replay event log '%s'", path ? path : "(PODI_REPLAY_FILE not set)");
+        replay_application_destroy((podi_application *)app);
+        return NULL;
+    }
+
+    return (podi_application *)app;
+}
+
+static void replay_application_destroy(podi_application *app_generic) {
+    podi_application_replay *app = (podi_application_replay *)app_generic;
+    if (!app) return;
+
+    while (app->common.window_count > 0) {
+        podi_window_destroy(app->common.windows[app->common.window_count - 1]);
+    }
+    free(app->common.windows);
+    podi_event_queue_free(&app->common.events);
+    podi_wakeup_destroy(&app->common.wakeup);
+
+    if (app->mapping) munmap(app->mapping, app->mapping_size);
+    free(app);
+}
+
+// Monotonic time a record is due, keeping the recorded spacing scaled by speed
+static uint64_t replay_record_time_ns(podi_application_replay *app, const podi_recorded_event *record) {
+    uint64_t recorded = record->event.timestamp_ns;
+    uint64_t elapsed = recorded > app->base_ns ? recorded - app->base_ns : 0;
+    if (app->speed > 0.0) {
+        elapsed = (uint64_t)((double)elapsed / app->speed);
+    }
+    return app->start_ns + elapsed;
+}
+
+// Windows get the same ids as in the recorded run when the application
+// creates them in the same order
+static podi_window *replay_find_window(podi_application_replay *app, uint32_t id) {
+    for (size_t i = 0; i < app->common.window_count; i++) {
+        podi_window_common *window = (podi_window_common *)app->common.windows[i];
+        if (window->id == id) return app->common.windows[i];
+    }
+    return NULL;
+}
+
+// Pushes every record that is due through the common delivery path
+static void replay_queue_due_events(podi_application_replay *app) {
+    podi_wakeup_drain(&app->common.wakeup, &app->common);
+
+    if (app->next_record < app->record_count && app->start_ns == 0) {
+        app->start_ns = podi_time_now_ns();
+        app->base_ns = app->records[app->next_record].event.timestamp_ns;
+    }
+
+    uint64_t now = podi_time_now_ns();
+    size_t batch = 0;
+    while (app->next_record < app->record_count) {
+        const podi_recorded_event *record = &app->records[app->next_record];
+        uint64_t due = replay_record_time_ns(app, record);
+        if (app->speed > 0.0 ? due > now : batch >= PODI_REPLAY_BATCH) break;
+        app->next_record++;
+        batch++;
+
+        podi_event event = record->event;
+        event.timestamp_ns = due;
+        if (record->window_id != PODI_RECORDING_NO_WINDOW) {
+            // Events for windows this run never created, or already closed, are skipped
+            event.window = replay_find_window(app, record->window_id);
+            if (!event.window) continue;
+        }
+
+        if (event.type == PODI_EVENT_WINDOW_RESIZE && event.window) {
+            podi_window_common *window = (podi_window_common *)event.window;
+            window->width = event.window_resize.width;
+            window->height = event.window_resize.height;
+        }
+
+        podi_application_push_event(&app->common, &event);
+    }
+
+    if (app->next_record >= app->record_count && app->common.events.count == 0) {
+        app->common.should_close = true;
+    }
+}
+
+static bool replay_application_poll_event(podi_application *app_generic, podi_event *event) {
+    podi_application_replay *app = (podi_application_replay *)app_generic;
+    if (!app || !event) return false;
+
+    if (app->common.events.count == 0) {
+        replay_queue_due_events(app);
+    }
+    return podi_event_queue_pop(&app->common.events, event);
+}
+
+static size_t replay_application_poll_events(podi_application *app_generic, podi_event *events, size_t capacity) {
+    podi_application_replay *app = (podi_application_replay *)app_generic;
+    if (!app || !events || capacity == 0) return 0;
+
+    if (app->common.events.count == 0) {
+        replay_queue_due_events(app);
+    }
+    return podi_event_queue_pop_many(&app->common.events, events, capacity);
+}
+
+static bool replay_application_wait_events(podi_application *app_generic, int64_t timeout_ns) {
+    podi_application_replay *app = (podi_application_replay *)app_generic;
+    if (!app) return false;
+
+    uint64_t delivered = app->common.delivered_count;
+    uint64_t start = podi_time_now_ns();
+    while (true) {
+        replay_queue_due_events(app);
+        if (podi_application_has_events(&app->common, delivered)) return true;
+        if (app->next_record >= app->record_count && timeout_ns < 0) return false;
+
+        // Sleep until the next record is due, the timeout expires or a wakeup arrives
+        uint64_t now = podi_time_now_ns();
+        int64_t sleep_ns = timeout_ns;
+        if (timeout_ns >= 0) {
+            uint64_t elapsed = now - start;
+            if (elapsed >= (uint64_t)timeout_ns) return false;
+            sleep_ns = timeout_ns - (int64_t)elapsed;
+        }
+        if (app->next_record < app->record_count) {
+            uint64_t due = replay_record_time_ns(app, &app->records[app->next_record]);
+            int64_t until_due = due > now ? (int64_t)(due - now) : 0;
+            if (sleep_ns < 0 || until_due < sleep_ns) sleep_ns = until_due;
+        }
+
+        struct pollfd pfd = { .fd = app->common.wakeup.fd, .events = POLLIN };
+        if (podi_poll(&pfd, 1, sleep_ns) > 0) {
+            podi_wakeup_acknowledge(&app->common.wakeup);
+        }
+    }
+}
+
+static bool replay_application_dispatch_events(podi_application *app_generic, bool fd_readable) {
+    podi_application_replay *app = (podi_application_replay *)app_generic;
+    if (!app) return false;
+
+    if (fd_readable) {
+        podi_wakeup_acknowledge(&app->common.wakeup);
+    }
+    replay_queue_due_events(app);
+    return true;
+}
+
+const podi_platform_vtable replay_vtable = {
+    .application_create = replay_application_create,
+    .application_destroy = replay_application_destroy,
+    .application_should_close = headless_application_should_close,
+    .application_close = headless_application_close,
+    .application_poll_event = replay_application_poll_event,
+    .application_poll_events = replay_application_poll_events,
+    .application_wait_events = replay_application_wait_events,
+    .application_dispatch_events = replay_application_dispatch_events,
+    .get_display_scale_factor = headless_get_display_scale_factor,
+    .window_create = headless_window_create,
+    .window_destroy = headless_window_destroy,
+    .window_close = headless_window_close,
+    .window_set_title = headless_window_set_title,
+    .window_set_size = headless_window_set_size,
+    .window_set_position_and_size = headless_window_set_position_and_size,
+    .window_get_size = headless_window_get_size,
+    .window_get_framebuffer_size = headless_window_get_size,
+    .window_get_surface_size = headless_window_get_size,
+    .window_get_scale_factor = headless_window_get_scale_factor,
+    .window_should_close = headless_window_should_close,
+    .window_begin_interactive_resize = headless_window_begin_interactive_resize,
+    .window_begin_move = headless_window_begin_move,
+    .window_set_cursor = headless_window_set_cursor,
+    .window_set_cursor_mode = headless_window_set_cursor_mode,
+    .window_get_cursor_position = headless_window_get_cursor_position,
+    .window_set_fullscreen_exclusive = headless_window_set_fullscreen_exclusive,
+    .window_is_fullscreen_exclusive = headless_window_is_fullscreen_exclusive,
+    .window_get_title_bar_height = headless_window_get_title_bar_height,
+    .window_get_x11_handles = headless_window_get_x11_handles,
+    .window_get_wayland_handles = headless_window_get_wayland_handles,
+};
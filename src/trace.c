@@ -0,0 +1,79 @@
+#define _GNU_SOURCE
+#include "internal.h"
+
+#ifdef PODI_ENABLE_TRACING
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Lazily opened from PODI_TRACE_FILE; NULL when tracing is off
+static FILE *trace_file = NULL;
+static pthread_once_t trace_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool trace_first_event = true;
+static long trace_pid = 0;
+
+// Small per-thread ids read better in the viewer than pthread_t values
+static atomic_uint trace_next_tid = 1;
+static _Thread_local unsigned int trace_tid = 0;
+
+static void podi_trace_close(void) {
+    pthread_mutex_lock(&trace_lock);
+    if (trace_file) {
+        fputs("\n]\n", trace_file);
+        fclose(trace_file);
+        trace_file = NULL;
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+static void podi_trace_open(void) {
+    const char *path = getenv("PODI_TRACE_FILE");
+    if (!path || !*path) return;
+
+    trace_file = fopen(path, "w");
+    if (!trace_file) {
+        PODI_LOG_ERROR("Cannot open trace file '%s'", path);
+        return;
+    }
+
+    trace_pid = (long)getpid();
+    fputs("[\n", trace_file);
+    atexit(podi_trace_close);
+}
+
+static void podi_trace_write(const char *name, char phase) {
+    pthread_once(&trace_once, podi_trace_open);
+    if (!trace_file) return;
+
+    if (trace_tid == 0) {
+        trace_tid = atomic_fetch_add(&trace_next_tid, 1);
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    double timestamp_us = (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+
+    pthread_mutex_lock(&trace_lock);
+    if (trace_file) {
+        fprintf(trace_file, "%s{\"name\":\"%s\",\"cat\":\"podi\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%ld,\"tid\":%u}",
+                trace_first_event ? "" : ",\n", name, phase, timestamp_us, trace_pid, trace_tid);
+        trace_first_event = false;
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+const char *podi_trace_begin(const char *name) {
+    podi_trace_write(name, 'B');
+    return name;
+}
+
+void podi_trace_end(const char *name) {
+    podi_trace_write(name, 'E');
+}
+
+void podi_trace_scope_end(const char **name) {
+    podi_trace_end(*name);
+}
+#endif